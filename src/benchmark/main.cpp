@@ -0,0 +1,243 @@
+// Copyright (c) Tyler Veness
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <print>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "flow_field.hpp"
+#include "frame_arena.hpp"
+#include "horde_config.hpp"
+#include "random.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+#include "zombie.hpp"
+
+namespace {
+
+/// Number of simulation steps timed per benchmark.
+constexpr int NUM_STEPS = 200;
+
+/// Simulation step duration in seconds.
+constexpr float STEP_DURATION = 1.f / 60.f;
+
+/// Returns zombies at reproducible random positions.
+///
+/// @param num_zombies Number of zombies.
+std::vector<Zombie> make_zombies(size_t num_zombies) {
+  Random random{num_zombies};
+
+  std::vector<Zombie> zombies;
+  zombies.reserve(num_zombies);
+  for (size_t i = 0; i < num_zombies; ++i) {
+    float x = random.uniform(100.f, MAP_DIMS.x - 100.f);
+    float y = random.uniform(100.f, MAP_DIMS.y - 100.f);
+    zombies.emplace_back(sf::Vector2f{x, y},
+                         i % 10 == 0 ? ZombieType::Big : ZombieType::Small);
+  }
+  return zombies;
+}
+
+/// Steps zombie movement with a player circling the map center and returns
+/// the mean step duration in milliseconds.
+///
+/// @param zombies The zombies.
+/// @param flow_field Flow field toward the player.
+/// @param thread_pool Thread pool to split the update across.
+double run_zombie_movement(std::vector<Zombie>& zombies, FlowField& flow_field,
+                           ThreadPool& thread_pool) {
+  using clock = std::chrono::steady_clock;
+
+  clock::duration total_time{0};
+  for (int step = 0; step < NUM_STEPS; ++step) {
+    float angle = static_cast<float>(step) * STEP_DURATION;
+    sf::Vector2f player_position =
+        MAP_DIMS / 2.f + 500.f * sf::Vector2f{std::cos(angle), std::sin(angle)};
+    sf::Vector2f player_velocity =
+        500.f * sf::Vector2f{-std::sin(angle), std::cos(angle)};
+
+    auto start_time = clock::now();
+    flow_field.update(player_position);
+    Zombie::update_movement(zombies, STEP_DURATION, player_position,
+                            player_velocity, flow_field, thread_pool);
+    total_time += clock::now() - start_time;
+  }
+
+  return std::chrono::duration<double, std::milli>{total_time}.count() /
+         NUM_STEPS;
+}
+
+/// Recomputes a flow field around walls for a target hopping between cells
+/// and returns the mean update duration in milliseconds.
+double run_flow_field_update() {
+  using clock = std::chrono::steady_clock;
+
+  // Vertical walls with alternating gaps at the top and bottom
+  FlowField flow_field;
+  const auto& size = flow_field.get_size();
+  for (int x = 8; x < size.x; x += 8) {
+    for (int y = 0; y < size.y; ++y) {
+      bool gap = (x / 8) % 2 == 0 ? y < 4 : y >= size.y - 4;
+      flow_field.set_blocked({x, y}, !gap);
+    }
+  }
+
+  clock::duration total_time{0};
+  for (int step = 0; step < NUM_STEPS; ++step) {
+    sf::Vector2f target{
+        static_cast<float>(step % size.x) * FlowField::CELL_SIZE,
+        static_cast<float>(step % size.y) * FlowField::CELL_SIZE};
+
+    auto start_time = clock::now();
+    flow_field.update(target);
+    total_time += clock::now() - start_time;
+  }
+
+  return std::chrono::duration<double, std::milli>{total_time}.count() /
+         NUM_STEPS;
+}
+
+/// Spawns waves of zombies into reserved storage and returns the mean wave
+/// duration in milliseconds.
+///
+/// @param wave_size Number of zombies per wave.
+double run_wave_spawn(uint32_t wave_size) {
+  using clock = std::chrono::steady_clock;
+
+  std::vector<Zombie> zombies;
+  zombies.reserve(wave_size);
+
+  clock::duration total_time{0};
+  for (int step = 0; step < NUM_STEPS; ++step) {
+    zombies.clear();
+
+    auto start_time = clock::now();
+    Zombie::spawn(zombies, wave_size, wave_size, 0.f);
+    total_time += clock::now() - start_time;
+  }
+
+  return std::chrono::duration<double, std::milli>{total_time}.count() /
+         NUM_STEPS;
+}
+
+/// Mean durations of saving and restoring a world snapshot.
+struct SnapshotTimes {
+  /// Snapshot size in bytes.
+  size_t bytes;
+
+  /// Mean save duration in microseconds.
+  double save_us;
+
+  /// Mean restore duration in microseconds.
+  double restore_us;
+};
+
+/// Saves and restores a world with a full horde.
+///
+/// @param num_zombies Number of zombies.
+SnapshotTimes run_snapshot(uint32_t num_zombies) {
+  using clock = std::chrono::steady_clock;
+
+  // The whole horde spawns in the first step
+  World world;
+  world.set_horde_config({.max_zombies = num_zombies,
+                          .ramp = HordeRamp::IMMEDIATE,
+                          .wave_size = num_zombies});
+  world.step(STEP_DURATION, PlayerInput{});
+  global_frame_arena().reset();
+
+  Snapshot snapshot;
+  clock::duration total_save_time{0};
+  clock::duration total_restore_time{0};
+  for (int step = 0; step < NUM_STEPS; ++step) {
+    auto start_time = clock::now();
+    world.save(snapshot);
+    auto save_end_time = clock::now();
+    world.restore(snapshot);
+    auto restore_end_time = clock::now();
+
+    total_save_time += save_end_time - start_time;
+    total_restore_time += restore_end_time - save_end_time;
+  }
+
+  return {snapshot.get_size(),
+          std::chrono::duration<double, std::micro>{total_save_time}.count() /
+              NUM_STEPS,
+          std::chrono::duration<double, std::micro>{total_restore_time}
+                  .count() /
+              NUM_STEPS};
+}
+
+/// Returns true if both zombie lists have bitwise equal positions and
+/// velocities.
+///
+/// @param lhs First zombie list.
+/// @param rhs Second zombie list.
+bool bitwise_equal(const std::vector<Zombie>& lhs,
+                   const std::vector<Zombie>& rhs) {
+  auto equal = [](const sf::Vector2f& a, const sf::Vector2f& b) {
+    return std::bit_cast<uint32_t>(a.x) == std::bit_cast<uint32_t>(b.x) &&
+           std::bit_cast<uint32_t>(a.y) == std::bit_cast<uint32_t>(b.y);
+  };
+
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (!equal(lhs[i].get_position(), rhs[i].get_position()) ||
+        !equal(lhs[i].get_velocity(), rhs[i].get_velocity())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool serial_pool{1};
+  auto& parallel_pool = global_thread_pool();
+
+  std::println("zombie movement ({} steps, {} threads)", NUM_STEPS,
+               parallel_pool.get_thread_count());
+  std::println("zombies,serial_ms,parallel_ms,speedup,bit_identical");
+
+  for (size_t num_zombies : std::array<size_t, 3>{1'000, 10'000, 100'000}) {
+    auto serial_zombies = make_zombies(num_zombies);
+    auto parallel_zombies = make_zombies(num_zombies);
+
+    FlowField serial_flow_field;
+    FlowField parallel_flow_field;
+    double serial_ms =
+        run_zombie_movement(serial_zombies, serial_flow_field, serial_pool);
+    double parallel_ms = run_zombie_movement(
+        parallel_zombies, parallel_flow_field, parallel_pool);
+
+    std::println("{},{:.4f},{:.4f},{:.2f},{}", num_zombies, serial_ms,
+                 parallel_ms, serial_ms / parallel_ms,
+                 bitwise_equal(serial_zombies, parallel_zombies));
+  }
+
+  std::println("world snapshot ({} steps)", NUM_STEPS);
+  std::println("zombies,bytes,save_us,restore_us");
+  for (uint32_t num_zombies :
+       std::array<uint32_t, 3>{1'000, 10'000, 100'000}) {
+    auto times = run_snapshot(num_zombies);
+    std::println("{},{},{:.2f},{:.2f}", num_zombies, times.bytes,
+                 times.save_us, times.restore_us);
+  }
+
+  std::println("flow field update: {:.4f} ms", run_flow_field_update());
+  std::println("wave spawn (100000 zombies): {:.4f} ms",
+               run_wave_spawn(100'000));
+}
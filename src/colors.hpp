@@ -0,0 +1,11 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+
+/// Window background color
+constexpr sf::Color BACKGROUND_COLOR = sf::Color::Black;
+
+/// Ground color
+constexpr sf::Color GROUND_COLOR{80, 80, 80};
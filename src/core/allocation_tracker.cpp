@@ -0,0 +1,247 @@
+// Copyright (c) Tyler Veness
+
+#include "allocation_tracker.hpp"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string_view>
+
+#include "phase.hpp"
+
+void AllocationTracker::begin_frame() {
+  for (size_t i = 0; i < current_counts.size(); ++i) {
+    auto& counts = current_counts[i];
+    last_counts[i] = {
+        counts.allocations.exchange(0, std::memory_order_relaxed),
+        counts.frees.exchange(0, std::memory_order_relaxed),
+        counts.allocated_bytes.exchange(0, std::memory_order_relaxed),
+        counts.freed_bytes.exchange(0, std::memory_order_relaxed)};
+  }
+}
+
+void AllocationTracker::record_allocation(size_t size) {
+  if (allocations_forbidden.load(std::memory_order_relaxed)) {
+    // Print without allocating
+    auto name = current_phase == UNTIMED_PHASE
+                    ? std::string_view{"untimed"}
+                    : phase_name(static_cast<Phase>(current_phase));
+    fprintf(stderr, "Forbidden allocation of %zu bytes in phase \"%.*s\"\n",
+            size, static_cast<int>(name.size()), name.data());
+    abort();
+  }
+
+  auto& counts = current_counts[current_phase];
+  counts.allocations.fetch_add(1, std::memory_order_relaxed);
+  counts.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+AllocationTracker& global_allocation_tracker() {
+  static AllocationTracker tracker;
+  return tracker;
+}
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+
+namespace {
+
+/// Bytes reserved in front of each allocation to store its size. This keeps
+/// the returned pointer aligned like a plain malloc().
+constexpr size_t HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+/// Allocates memory and records the allocation.
+///
+/// @param size Allocation size in bytes.
+/// @return The allocated memory, or nullptr on failure.
+void* tracked_allocate(size_t size) {
+  auto block = static_cast<char*>(malloc(HEADER_SIZE + size));
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  *reinterpret_cast<size_t*>(block) = size;
+  global_allocation_tracker().record_allocation(size);
+
+  return block + HEADER_SIZE;
+}
+
+/// Frees memory from tracked_allocate() and records the free.
+///
+/// @param ptr The memory to free.
+void tracked_free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto block = static_cast<char*>(ptr) - HEADER_SIZE;
+  global_allocation_tracker().record_free(*reinterpret_cast<size_t*>(block));
+
+  free(block);
+}
+
+/// Returns the size of the header in front of an allocation with the given
+/// alignment. It's a multiple of the alignment, so the returned pointer stays
+/// aligned.
+///
+/// @param alignment Allocation alignment in bytes.
+size_t aligned_header_size(std::align_val_t alignment) {
+  return std::max(HEADER_SIZE, static_cast<size_t>(alignment));
+}
+
+/// Allocates aligned memory and records the allocation.
+///
+/// @param size Allocation size in bytes.
+/// @param alignment Allocation alignment in bytes.
+/// @return The allocated memory, or nullptr on failure.
+void* tracked_allocate(size_t size, std::align_val_t alignment) {
+  size_t header_size = aligned_header_size(alignment);
+#if defined(_WIN32)
+  auto block =
+      static_cast<char*>(_aligned_malloc(header_size + size, header_size));
+#else
+  // aligned_alloc() wants the size to be a multiple of the alignment
+  size_t block_size =
+      (header_size + size + header_size - 1) / header_size * header_size;
+  auto block = static_cast<char*>(aligned_alloc(header_size, block_size));
+#endif
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  // The size goes right in front of the returned pointer
+  auto ptr = block + header_size;
+  *reinterpret_cast<size_t*>(ptr - sizeof(size_t)) = size;
+  global_allocation_tracker().record_allocation(size);
+
+  return ptr;
+}
+
+/// Frees memory from the aligned tracked_allocate() and records the free.
+///
+/// @param ptr The memory to free.
+/// @param alignment Alignment the memory was allocated with.
+void tracked_free(void* ptr, std::align_val_t alignment) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto bytes = static_cast<char*>(ptr);
+  global_allocation_tracker().record_free(
+      *reinterpret_cast<size_t*>(bytes - sizeof(size_t)));
+
+  auto block = bytes - aligned_header_size(alignment);
+#if defined(_WIN32)
+  _aligned_free(block);
+#else
+  free(block);
+#endif
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  if (void* ptr = tracked_allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) {
+  if (void* ptr = tracked_allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return tracked_allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return tracked_allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  tracked_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  tracked_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  tracked_free(ptr);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  if (void* ptr = tracked_allocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  if (void* ptr = tracked_allocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return tracked_allocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return tracked_allocate(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+void operator delete[](void* ptr, size_t,
+                       std::align_val_t alignment) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment,
+                       const std::nothrow_t&) noexcept {
+  tracked_free(ptr, alignment);
+}
+
+#endif  // ENABLE_ALLOCATION_TRACKING
@@ -0,0 +1,130 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <utility>
+
+#include "phase.hpp"
+
+// NB: Heap allocations are only tracked if ENABLE_ALLOCATION_TRACKING is
+// defined (see the ENABLE_ALLOCATION_TRACKING CMake option), in which case
+// allocation_tracker.cpp replaces the global operator new and operator delete.
+// Otherwise, all counts stay zero.
+
+/// Heap allocation counts.
+struct AllocationCounts {
+  /// Number of allocations.
+  uint64_t allocations = 0;
+
+  /// Number of frees.
+  uint64_t frees = 0;
+
+  /// Number of bytes allocated.
+  uint64_t allocated_bytes = 0;
+
+  /// Number of bytes freed.
+  uint64_t freed_bytes = 0;
+
+  AllocationCounts& operator+=(const AllocationCounts& rhs) {
+    allocations += rhs.allocations;
+    frees += rhs.frees;
+    allocated_bytes += rhs.allocated_bytes;
+    freed_bytes += rhs.freed_bytes;
+    return *this;
+  }
+};
+
+/// Counts heap allocations and frees per frame, broken down by the profiler
+/// phase they were made in.
+class AllocationTracker {
+ public:
+#ifdef ENABLE_ALLOCATION_TRACKING
+  static constexpr bool ENABLED = true;
+#else
+  static constexpr bool ENABLED = false;
+#endif
+
+  /// Phase index used for allocations made outside of any timed phase.
+  static constexpr int UNTIMED_PHASE = NUM_PHASES;
+
+  /// Finishes the current frame and starts a new one.
+  void begin_frame();
+
+  /// Returns the allocations made in the given phase during the last finished
+  /// frame.
+  ///
+  /// @param phase The phase.
+  const AllocationCounts& get_phase_counts(Phase phase) const {
+    return last_counts[std::to_underlying(phase)];
+  }
+
+  /// Returns the allocations made outside of any timed phase during the last
+  /// finished frame.
+  const AllocationCounts& get_untimed_counts() const {
+    return last_counts[UNTIMED_PHASE];
+  }
+
+  /// Returns all allocations made during the last finished frame.
+  AllocationCounts get_frame_counts() const {
+    AllocationCounts counts;
+    for (const auto& phase_counts : last_counts) {
+      counts += phase_counts;
+    }
+    return counts;
+  }
+
+  /// Sets whether heap allocations are forbidden. If they are, the next
+  /// allocation on any thread prints the phase it was made in and aborts, so a
+  /// debugger stops at the offending call stack.
+  ///
+  /// @param forbidden Whether heap allocations are forbidden.
+  void set_allocations_forbidden(bool forbidden) {
+    allocations_forbidden.store(forbidden, std::memory_order_relaxed);
+  }
+
+  /// Records an allocation in the calling thread's current phase.
+  ///
+  /// @param size Allocation size in bytes.
+  void record_allocation(size_t size);
+
+  /// Records a free in the calling thread's current phase.
+  ///
+  /// @param size Allocation size in bytes.
+  void record_free(size_t size) {
+    auto& counts = current_counts[current_phase];
+    counts.frees.fetch_add(1, std::memory_order_relaxed);
+    counts.freed_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  /// Sets the calling thread's current phase.
+  ///
+  /// @param phase Phase index, or UNTIMED_PHASE.
+  /// @return The previous phase index.
+  static int set_current_phase(int phase) {
+    int previous_phase = current_phase;
+    current_phase = phase;
+    return previous_phase;
+  }
+
+ private:
+  struct AtomicCounts {
+    std::atomic<uint64_t> allocations = 0;
+    std::atomic<uint64_t> frees = 0;
+    std::atomic<uint64_t> allocated_bytes = 0;
+    std::atomic<uint64_t> freed_bytes = 0;
+  };
+
+  static inline thread_local int current_phase = UNTIMED_PHASE;
+
+  std::array<AtomicCounts, NUM_PHASES + 1> current_counts{};
+  std::array<AllocationCounts, NUM_PHASES + 1> last_counts{};
+  std::atomic<bool> allocations_forbidden = false;
+};
+
+/// Returns the application-wide allocation tracker.
+AllocationTracker& global_allocation_tracker();
@@ -0,0 +1,167 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <span>
+#include <vector>
+
+/// Packs values into a byte buffer using as few bits as each needs.
+///
+/// Bits are written least significant first. The buffer keeps its capacity
+/// across clear().
+class BitWriter {
+ public:
+  /// Discards the contents but keeps the buffer.
+  void clear() {
+    bytes.clear();
+    scratch = 0;
+    scratch_bits = 0;
+  }
+
+  /// Appends the low bits of a value.
+  ///
+  /// @param value The value.
+  /// @param num_bits Number of bits, at most 32.
+  void write(uint32_t value, int num_bits) {
+    if (num_bits < 32) {
+      value &= (uint32_t{1} << num_bits) - 1;
+    }
+    scratch |= uint64_t{value} << scratch_bits;
+    scratch_bits += num_bits;
+    while (scratch_bits >= 8) {
+      bytes.push_back(static_cast<uint8_t>(scratch));
+      scratch >>= 8;
+      scratch_bits -= 8;
+    }
+  }
+
+  /// Appends a bool as one bit.
+  ///
+  /// @param value The value.
+  void write_bool(bool value) { write(value, 1); }
+
+  /// Appends an unsigned value in 7-bit groups, so small values take fewer
+  /// bits.
+  ///
+  /// @param value The value.
+  void write_varint(uint32_t value) {
+    while (value >= 0x80) {
+      write((value & 0x7f) | 0x80, 8);
+      value >>= 7;
+    }
+    write(value, 8);
+  }
+
+  /// Appends a signed value. Values that fit in small_bits as two's
+  /// complement take a flag bit plus small_bits, and others take a flag bit
+  /// plus large_bits.
+  ///
+  /// @param value The value.
+  /// @param small_bits Number of bits for small values.
+  /// @param large_bits Number of bits for other values.
+  void write_signed(int32_t value, int small_bits, int large_bits) {
+    int32_t small_limit = int32_t{1} << (small_bits - 1);
+    bool small = value >= -small_limit && value < small_limit;
+    write_bool(small);
+    write(static_cast<uint32_t>(value), small ? small_bits : large_bits);
+  }
+
+  /// Returns the bytes written so far. A partial last byte is padded with
+  /// zeroes.
+  std::span<const uint8_t> get_bytes() {
+    if (scratch_bits > 0) {
+      bytes.push_back(static_cast<uint8_t>(scratch));
+      scratch = 0;
+      scratch_bits = 0;
+    }
+    return bytes;
+  }
+
+ private:
+  std::vector<uint8_t> bytes;
+
+  /// Bits not yet making up a whole byte.
+  uint64_t scratch = 0;
+  int scratch_bits = 0;
+};
+
+/// Unpacks values written by a BitWriter.
+///
+/// Reading past the end returns zeroes and marks the reader as overflowed, so
+/// truncated or malformed input can be rejected after parsing.
+class BitReader {
+ public:
+  /// Constructs a BitReader positioned at the start of a buffer.
+  ///
+  /// @param bytes The buffer. It must outlive the reader.
+  explicit BitReader(std::span<const uint8_t> bytes) : bytes{bytes} {}
+
+  /// Reads an unsigned value.
+  ///
+  /// @param num_bits Number of bits, at most 32.
+  uint32_t read(int num_bits) {
+    while (scratch_bits < num_bits) {
+      if (offset < bytes.size()) {
+        scratch |= uint64_t{bytes[offset++]} << scratch_bits;
+      } else {
+        overflowed = true;
+      }
+      scratch_bits += 8;
+    }
+
+    auto value = static_cast<uint32_t>(scratch);
+    if (num_bits < 32) {
+      value &= (uint32_t{1} << num_bits) - 1;
+    }
+    scratch >>= num_bits;
+    scratch_bits -= num_bits;
+    return value;
+  }
+
+  /// Reads a bool.
+  bool read_bool() { return read(1) != 0; }
+
+  /// Reads a value written by BitWriter::write_varint().
+  uint32_t read_varint() {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+      uint32_t group = read(8);
+      value |= (group & 0x7f) << shift;
+      if ((group & 0x80) == 0) {
+        break;
+      }
+    }
+    return value;
+  }
+
+  /// Reads a value written by BitWriter::write_signed().
+  ///
+  /// @param small_bits Number of bits for small values.
+  /// @param large_bits Number of bits for other values.
+  int32_t read_signed(int small_bits, int large_bits) {
+    int num_bits = read_bool() ? small_bits : large_bits;
+    uint32_t value = read(num_bits);
+
+    // Sign-extend
+    if (num_bits < 32 && (value & (uint32_t{1} << (num_bits - 1)))) {
+      value |= ~((uint32_t{1} << num_bits) - 1);
+    }
+    return static_cast<int32_t>(value);
+  }
+
+  /// Returns true if a read went past the end of the buffer.
+  bool has_overflowed() const { return overflowed; }
+
+ private:
+  std::span<const uint8_t> bytes;
+  size_t offset = 0;
+
+  /// Bits read from the buffer but not yet returned.
+  uint64_t scratch = 0;
+  int scratch_bits = 0;
+
+  bool overflowed = false;
+};
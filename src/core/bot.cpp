@@ -0,0 +1,62 @@
+// Copyright (c) Tyler Veness
+
+#include "bot.hpp"
+
+#include <limits>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "flee_steering.hpp"
+#include "trace.hpp"
+#include "weapon_type.hpp"
+#include "world.hpp"
+
+PlayerInput Bot::update(const World& world) const {
+  TRACE_SCOPE("bot");
+
+  const auto& player = world.get_player();
+  const auto& position = player.get_position();
+
+  PlayerInput input;
+
+  // Flee zombies and shoot the nearest one
+  FleeSteering steering{position, player.get_radius()};
+  for (const auto& zombie : world.get_zombies()) {
+    steering.add_zombie(zombie.get_position(), zombie.get_radius());
+  }
+  if (const auto& nearest = steering.get_nearest_zombie_position()) {
+    input.aim_target = *nearest;
+    input.fire = true;
+  }
+
+  if (steering.is_fleeing()) {
+    input.direction = steering.get_flee_direction();
+  } else {
+    // Walk toward the nearest weapon crate when no zombies are close
+    float nearest_crate_distance = std::numeric_limits<float>::infinity();
+    for (const auto& crate : world.get_weapon_crates()) {
+      auto toward = crate.get_position() - position;
+      if (toward.length() < nearest_crate_distance) {
+        nearest_crate_distance = toward.length();
+        input.direction = toward;
+      }
+    }
+
+    input.direction += steering.get_edge_direction();
+  }
+
+  input.sprint = steering.get_nearest_zombie_distance() < SPRINT_RADIUS;
+
+  // Switch away from empty weapons, preferring ones later in the weapon list
+  if (player.get_current_weapon().ammo == 0) {
+    for (int i = NUM_WEAPONS - 1; i >= 0; --i) {
+      auto type = static_cast<WeaponType>(i);
+      if (player.get_weapon(type).ammo > 0) {
+        input.weapon = type;
+        break;
+      }
+    }
+  }
+
+  return input;
+}
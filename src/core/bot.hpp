@@ -0,0 +1,23 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include "world.hpp"
+
+/// Autoplay bot that generates player input from the world state.
+///
+/// The bot flees nearby zombies, walks toward weapon crates when it's safe,
+/// sprints when zombies get close, and fires at the nearest zombie. It's
+/// intended for long-running soak and scaling tests rather than for playing
+/// well.
+class Bot {
+ public:
+  /// Returns the input the bot would give for the current world state.
+  ///
+  /// @param world The world.
+  PlayerInput update(const World& world) const;
+
+ private:
+  /// Zombies closer than this many pixels make the bot sprint.
+  static constexpr float SPRINT_RADIUS = 120.f;
+};
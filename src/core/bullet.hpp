@@ -0,0 +1,194 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "weapon_type.hpp"
+
+enum class BulletShape { CIRCLE, RECTANGLE, CONVEX };
+
+/// Bullet's maximum lifetime in seconds.
+constexpr float BULLET_MAX_LIFETIME = 1.f;
+
+/// Rocket body outline used by convex bullets. The rocket's tip is at the
+/// origin and it points along the +x axis.
+constexpr std::array<sf::Vector2f, 7> ROCKET_POINTS{
+    sf::Vector2f{0.f, 0.f},     sf::Vector2f{-6.f, -4.f},
+    sf::Vector2f{-13.5f, -4.f}, sf::Vector2f{-18.f, -7.f},
+    sf::Vector2f{-18.f, 7.f},   sf::Vector2f{-13.5f, 4.f},
+    sf::Vector2f{-6.f, 4.f}};
+
+/// Bullet entity.
+class Bullet {
+ public:
+  /// Constructs a Bullet of the given weapon type.
+  ///
+  /// @param position Initial position.
+  /// @param velocity Initial velocity.
+  /// @param type Weapon type this bullet came from.
+  /// @param damage Damage.
+  /// @param bullet_shape Bullet shape.
+  /// @param size Body size (rectangle size or circle diameter). Convex bullets
+  ///     use ROCKET_POINTS and ignore this.
+  /// @param outline_thickness Body outline thickness.
+  Bullet(const sf::Vector2f& position, const sf::Vector2f& velocity,
+         WeaponType type, int damage, BulletShape bullet_shape,
+         const sf::Vector2f& size = {}, float outline_thickness = 0.f)
+      : position{position},
+        velocity{velocity},
+        rotation{velocity.angle()},
+        type{type},
+        damage{damage},
+        bullet_shape{bullet_shape},
+        size{size},
+        outline_thickness{outline_thickness} {
+    if (bullet_shape == BulletShape::CONVEX) {
+      sf::Vector2f min = ROCKET_POINTS[0];
+      sf::Vector2f max = ROCKET_POINTS[0];
+      for (const auto& point : ROCKET_POINTS) {
+        min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+        max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+      }
+      bounds_offset = min;
+      this->size = max - min;
+      origin = rocket_centroid();
+    } else {
+      // Rotate around the body's center
+      origin = size / 2.f;
+    }
+  }
+
+  Bullet(Bullet&&) = default;
+  Bullet& operator=(Bullet&&) = default;
+
+  /// Returns the position.
+  const sf::Vector2f& get_position() const { return position; }
+
+  /// Returns the velocity.
+  const sf::Vector2f& get_velocity() const { return velocity; }
+
+  /// Returns the rotation.
+  sf::Angle get_rotation() const { return rotation; }
+
+  /// Returns the weapon type this bullet came from.
+  const WeaponType& get_type() const { return type; }
+
+  /// Returns the damage this bullet is capable of.
+  float get_damage() const { return damage; }
+
+  /// Returns the body size (rectangle size, circle diameter, or convex
+  /// bounding box size) excluding the outline.
+  const sf::Vector2f& get_size() const { return size; }
+
+  /// Returns the body outline thickness.
+  float get_outline_thickness() const { return outline_thickness; }
+
+  /// Returns the body's origin relative to its unrotated top-left corner.
+  const sf::Vector2f& get_origin() const { return origin; }
+
+  /// Returns the bullet's age in seconds of simulation time.
+  float get_age() const { return age; }
+
+  /// Returns the bullet's ID, which orders bullets by when they were added to
+  /// the world.
+  uint32_t get_id() const { return id; }
+
+  /// Sets the bullet's ID.
+  ///
+  /// @param id The ID.
+  void set_id(uint32_t id) { this->id = id; }
+
+  /// Returns the global bounds for collision detection.
+  sf::FloatRect get_global_bounds() const {
+    // Local bounds including outline, relative to the origin
+    sf::Vector2f local_min =
+        bounds_offset - origin -
+        sf::Vector2f{outline_thickness, outline_thickness};
+    sf::Vector2f local_max =
+        local_min + size + 2.f * sf::Vector2f{outline_thickness,
+                                              outline_thickness};
+
+    std::array corners{local_min, sf::Vector2f{local_max.x, local_min.y},
+                       local_max, sf::Vector2f{local_min.x, local_max.y}};
+
+    sf::Vector2f min = corners[0].rotatedBy(rotation);
+    sf::Vector2f max = min;
+    for (const auto& corner : corners) {
+      auto rotated = corner.rotatedBy(rotation);
+      min = {std::min(min.x, rotated.x), std::min(min.y, rotated.y)};
+      max = {std::max(max.x, rotated.x), std::max(max.y, rotated.y)};
+    }
+
+    return sf::FloatRect{position + min, max - min};
+  }
+
+  /// Returns the bullet shape.
+  BulletShape get_shape() const { return bullet_shape; }
+
+  /// Moves the bullet back along its path and makes it younger, as if it had
+  /// been fired later. The next update_movement() then leaves it where a
+  /// bullet fired partway through the frame would be.
+  ///
+  /// @param duration How much later it's fired in seconds.
+  void delay(float duration) {
+    position -= velocity * duration;
+    age -= duration;
+  }
+
+  /// Steps simulation forward by one frame.
+  ///
+  /// @param frame_duration Frame duration in seconds.
+  void update_movement(float frame_duration) {
+    sf::Vector2f delta_position = velocity * frame_duration;
+
+    if (MAP_BOUNDS.contains(position + delta_position)) {
+      position += delta_position;
+    }
+
+    age += frame_duration;
+  }
+
+ private:
+  sf::Vector2f position;
+  sf::Vector2f velocity;
+  sf::Angle rotation;
+
+  WeaponType type;
+  int damage;
+
+  uint32_t id = 0;
+  float age = 0.f;
+
+  BulletShape bullet_shape;
+  sf::Vector2f size;
+  float outline_thickness;
+
+  /// Top-left corner of the unoutlined body in local coordinates.
+  sf::Vector2f bounds_offset{0.f, 0.f};
+
+  /// Rotation origin in local coordinates.
+  sf::Vector2f origin;
+
+  /// Returns the area-weighted centroid of ROCKET_POINTS.
+  static sf::Vector2f rocket_centroid() {
+    float area = 0.f;
+    sf::Vector2f centroid{0.f, 0.f};
+    for (size_t i = 0; i < ROCKET_POINTS.size(); ++i) {
+      const auto& a = ROCKET_POINTS[i];
+      const auto& b = ROCKET_POINTS[(i + 1) % ROCKET_POINTS.size()];
+      float cross = a.cross(b);
+      area += cross;
+      centroid += (a + b) * cross;
+    }
+    return centroid / (3.f * area);
+  }
+};
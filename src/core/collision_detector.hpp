@@ -6,6 +6,8 @@
 #include <SFML/System/Vector2.hpp>
 #include <sleipnir/optimization/problem.hpp>
 
+#include "trace.hpp"
+
 template <>
 inline sf::Vector2<slp::Variable<double>>
 sf::Vector2<slp::Variable<double>>::rotatedBy(sf::Angle phi) const {
@@ -23,6 +25,8 @@ class CollisionDetector {
  public:
   /// Constructs a CollisionDetector.
   CollisionDetector() {
+    TRACE_SCOPE("collision setup");
+
     // Finds scaling factor α for which all shapes intersect
     α = problem.decision_variable();
     α.set_value(1.0);
@@ -31,8 +35,14 @@ class CollisionDetector {
 
     auto x = problem.decision_variable(2);
     point = sf::Vector2<slp::Variable<double>>{x[0], x[1]};
+
+    problem.add_callback(
+        [this](const slp::IterationInfo<double>&) { ++iterations; });
   }
 
+  CollisionDetector(const CollisionDetector&) = delete;
+  CollisionDetector& operator=(const CollisionDetector&) = delete;
+
   /// Adds circle object.
   ///
   /// @param center Circle center.
@@ -69,13 +79,23 @@ class CollisionDetector {
 
   /// Returns true if all shapes collide.
   bool collides() {
+    TRACE_SCOPE("collision solve");
+
     point.x.set_value(initial_guess.x);
     point.y.set_value(initial_guess.y);
 
     // Find scaling factor α for which all shapes intersect
-    return problem.solve() == slp::ExitStatus::SUCCESS && α < 1.0;
+    iterations = 0;
+    exit_status = problem.solve();
+    return exit_status == slp::ExitStatus::SUCCESS && α < 1.0;
   }
 
+  /// Returns the number of solver iterations taken by the last collides().
+  int get_iterations() const { return iterations; }
+
+  /// Returns the solver exit status of the last collides().
+  slp::ExitStatus get_exit_status() const { return exit_status; }
+
  private:
   slp::Problem<double> problem;
   slp::Variable<double> α;
@@ -84,6 +104,9 @@ class CollisionDetector {
   sf::Vector2f initial_guess{0.f, 0.f};
   int num_shapes = 0;
 
+  int iterations = 0;
+  slp::ExitStatus exit_status = slp::ExitStatus::SUCCESS;
+
   /// Add the given point to the running average initial guess.
   ///
   /// @param point Point to add.
@@ -0,0 +1,66 @@
+// Copyright (c) Tyler Veness
+
+#include "collision_stats.hpp"
+
+#include <array>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "weapon_type.hpp"
+
+namespace {
+
+constexpr std::array<std::string_view, NUM_WEAPONS> WEAPON_NAMES{
+    "handgun", "machine gun", "flamethrower", "laser",
+    "shotgun", "minigun",     "rocket launcher"};
+
+}  // namespace
+
+CollisionCounts& CollisionCounts::operator+=(const CollisionCounts& rhs) {
+  candidate_pairs += rhs.candidate_pairs;
+  aabb_rejects += rhs.aabb_rejects;
+  for (int i = 0; i < NUM_SHAPE_PAIRS; ++i) {
+    narrowphase_tests[i] += rhs.narrowphase_tests[i];
+  }
+  for (int i = 0; i < NUM_WEAPONS; ++i) {
+    weapon_narrowphase_tests[i] += rhs.weapon_narrowphase_tests[i];
+    weapon_solver_iterations[i] += rhs.weapon_solver_iterations[i];
+  }
+  solver_iterations += rhs.solver_iterations;
+  solver_failures += rhs.solver_failures;
+  hits += rhs.hits;
+  kills += rhs.kills;
+  return *this;
+}
+
+std::string CollisionCounts::to_string() const {
+  std::string str = std::format(
+      "candidate pairs: {}\n"
+      "AABB rejects: {}\n"
+      "narrowphase tests: {}\n",
+      candidate_pairs, aabb_rejects, get_narrowphase_tests());
+  for (int i = 0; i < NUM_SHAPE_PAIRS; ++i) {
+    std::format_to(std::back_inserter(str), "  {}: {}\n",
+                   shape_pair_name(static_cast<ShapePair>(i)),
+                   narrowphase_tests[i]);
+  }
+  std::format_to(std::back_inserter(str),
+                 "solver iterations: {}\n"
+                 "solver failures: {}\n"
+                 "hits: {}\n"
+                 "kills: {}\n"
+                 "bullet narrowphase per weapon (tests, solver iterations):\n",
+                 solver_iterations, solver_failures, hits, kills);
+  for (int i = 0; i < NUM_WEAPONS; ++i) {
+    std::format_to(std::back_inserter(str), "  {}: {}, {}\n", WEAPON_NAMES[i],
+                   weapon_narrowphase_tests[i], weapon_solver_iterations[i]);
+  }
+  return str;
+}
+
+CollisionStats& global_collision_stats() {
+  static CollisionStats stats;
+  return stats;
+}
@@ -0,0 +1,96 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "weapon_type.hpp"
+
+/// Shape pairs tested by the narrowphase.
+enum class ShapePair : uint8_t { CIRCLE_CIRCLE, CIRCLE_RECTANGLE, CIRCLE_CONVEX };
+
+constexpr int NUM_SHAPE_PAIRS = 3;
+
+/// Returns a human-readable name for the given shape pair.
+constexpr std::string_view shape_pair_name(ShapePair shape_pair) {
+  constexpr std::array<std::string_view, NUM_SHAPE_PAIRS> NAMES{
+      "circle-circle", "circle-rectangle", "circle-convex"};
+  return NAMES[std::to_underlying(shape_pair)];
+}
+
+/// Collision pipeline counters.
+struct CollisionCounts {
+  /// Number of pairs considered by the broadphase.
+  uint64_t candidate_pairs = 0;
+
+  /// Number of candidate pairs whose bounding boxes don't intersect.
+  uint64_t aabb_rejects = 0;
+
+  /// Number of narrowphase tests per shape pair.
+  std::array<uint64_t, NUM_SHAPE_PAIRS> narrowphase_tests{};
+
+  /// Number of bullet narrowphase tests per weapon type.
+  std::array<uint64_t, NUM_WEAPONS> weapon_narrowphase_tests{};
+
+  /// Number of bullet narrowphase solver iterations per weapon type.
+  std::array<uint64_t, NUM_WEAPONS> weapon_solver_iterations{};
+
+  /// Number of narrowphase solver iterations.
+  uint64_t solver_iterations = 0;
+
+  /// Number of narrowphase solves that didn't succeed.
+  uint64_t solver_failures = 0;
+
+  /// Number of bullet hits on zombies.
+  uint64_t hits = 0;
+
+  /// Number of zombies killed, including by area damage.
+  uint64_t kills = 0;
+
+  CollisionCounts& operator+=(const CollisionCounts& rhs);
+
+  /// Returns the total number of narrowphase tests.
+  uint64_t get_narrowphase_tests() const {
+    uint64_t tests = 0;
+    for (auto count : narrowphase_tests) {
+      tests += count;
+    }
+    return tests;
+  }
+
+  /// Returns a multiline human-readable summary of the counters.
+  std::string to_string() const;
+};
+
+/// Collects collision pipeline counters per frame and over the session.
+class CollisionStats {
+ public:
+  /// Finishes the current frame and starts a new one.
+  void begin_frame() {
+    last_frame_counts = current_counts;
+    session_counts += current_counts;
+    current_counts = {};
+  }
+
+  /// Returns the counters of the current frame for updating.
+  CollisionCounts& get_current_counts() { return current_counts; }
+
+  /// Returns the counters of the last finished frame.
+  const CollisionCounts& get_frame_counts() const { return last_frame_counts; }
+
+  /// Returns the counters summed over all finished frames.
+  const CollisionCounts& get_session_counts() const { return session_counts; }
+
+ private:
+  CollisionCounts current_counts;
+  CollisionCounts last_frame_counts;
+  CollisionCounts session_counts;
+};
+
+/// Returns the application-wide collision statistics.
+CollisionStats& global_collision_stats();
@@ -0,0 +1,41 @@
+// Copyright (c) Tyler Veness
+
+#include "flee_steering.hpp"
+
+#include <algorithm>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+
+void FleeSteering::add_zombie(const sf::Vector2f& zombie_position,
+                              float zombie_radius) {
+  auto away = position - zombie_position;
+  float distance = std::max(away.length() - zombie_radius - radius, 1.f);
+
+  if (distance < nearest_zombie_distance) {
+    nearest_zombie_distance = distance;
+    nearest_zombie_position = zombie_position;
+  }
+
+  if (distance < FLEE_RADIUS && (away.x != 0.f || away.y != 0.f)) {
+    flee_direction += away / (away.length() * distance);
+  }
+}
+
+sf::Vector2f FleeSteering::get_edge_direction() const {
+  sf::Vector2f edge_direction;
+  if (position.x < MAP_BOUNDS.position.x + EDGE_MARGIN) {
+    edge_direction.x += 1.f;
+  } else if (position.x > MAP_BOUNDS.position.x + MAP_BOUNDS.size.x -
+                              EDGE_MARGIN) {
+    edge_direction.x -= 1.f;
+  }
+  if (position.y < MAP_BOUNDS.position.y + EDGE_MARGIN) {
+    edge_direction.y += 1.f;
+  } else if (position.y > MAP_BOUNDS.position.y + MAP_BOUNDS.size.y -
+                              EDGE_MARGIN) {
+    edge_direction.y -= 1.f;
+  }
+  return edge_direction;
+}
@@ -0,0 +1,66 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <limits>
+#include <optional>
+
+#include <SFML/System/Vector2.hpp>
+
+/// Steers a player away from nearby zombies and map edges.
+///
+/// It works from positions and radii alone, so the autoplay bot can feed it
+/// the world and scripted network clients can feed it decoded snapshots.
+class FleeSteering {
+ public:
+  /// Constructs a FleeSteering with no zombies.
+  ///
+  /// @param position The player's position.
+  /// @param radius The player's radius.
+  FleeSteering(const sf::Vector2f& position, float radius)
+      : position{position}, radius{radius} {}
+
+  /// Accounts for a zombie.
+  ///
+  /// @param zombie_position The zombie's position.
+  /// @param zombie_radius The zombie's radius.
+  void add_zombie(const sf::Vector2f& zombie_position, float zombie_radius);
+
+  /// Returns the position of the nearest zombie, if any.
+  const std::optional<sf::Vector2f>& get_nearest_zombie_position() const {
+    return nearest_zombie_position;
+  }
+
+  /// Returns the gap between the player and the nearest zombie in pixels, at
+  /// least 1, or infinity if there are no zombies.
+  float get_nearest_zombie_distance() const { return nearest_zombie_distance; }
+
+  /// Returns whether any zombie is close enough to flee from.
+  bool is_fleeing() const {
+    return flee_direction.x != 0.f || flee_direction.y != 0.f;
+  }
+
+  /// Returns the unit direction away from nearby zombies, weighting closer
+  /// ones more heavily, plus get_edge_direction(). Only valid if is_fleeing().
+  sf::Vector2f get_flee_direction() const {
+    return flee_direction.normalized() + get_edge_direction();
+  }
+
+  /// Returns the direction away from nearby map edges, so the player doesn't
+  /// get cornered. Each component is -1, 0, or 1.
+  sf::Vector2f get_edge_direction() const;
+
+ private:
+  /// Zombies closer than this many pixels repel the player.
+  static constexpr float FLEE_RADIUS = 300.f;
+
+  /// Map edges closer than this many pixels repel the player.
+  static constexpr float EDGE_MARGIN = 150.f;
+
+  sf::Vector2f position;
+  float radius;
+
+  std::optional<sf::Vector2f> nearest_zombie_position;
+  float nearest_zombie_distance = std::numeric_limits<float>::infinity();
+  sf::Vector2f flee_direction;
+};
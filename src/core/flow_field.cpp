@@ -0,0 +1,224 @@
+// Copyright (c) Tyler Veness
+
+#include "flow_field.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "trace.hpp"
+
+namespace {
+
+/// Offsets to the eight neighbors of a cell.
+constexpr std::array<sf::Vector2i, 8> NEIGHBOR_OFFSETS{
+    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+/// Returns -1, 0, or 1 matching the sign of the given value.
+///
+/// @param value The value.
+constexpr int sign(int value) {
+  return (value > 0) - (value < 0);
+}
+
+}  // namespace
+
+FlowField::FlowField()
+    : size{static_cast<int>(std::ceil(MAP_BOUNDS.size.x / CELL_SIZE)),
+           static_cast<int>(std::ceil(MAP_BOUNDS.size.y / CELL_SIZE))},
+      blocked(static_cast<size_t>(size.x) * size.y, 0),
+      costs(blocked.size(), UNREACHABLE),
+      visible(blocked.size(), 0),
+      directions(blocked.size()) {
+  // Each cell is queued at most once per neighbor
+  for (auto& bucket : buckets) {
+    bucket.reserve(blocked.size());
+  }
+}
+
+void FlowField::set_blocked(const sf::Vector2i& cell, bool blocked) {
+  auto& cell_blocked = this->blocked[get_index(cell)];
+  if (cell_blocked != blocked) {
+    cell_blocked = blocked;
+    dirty = true;
+  }
+}
+
+bool FlowField::update(const sf::Vector2f& target) {
+  auto cell = get_cell(target);
+  if (!dirty && target_cell == cell) {
+    return false;
+  }
+
+  TRACE_SCOPE("flow field update");
+
+  target_cell = cell;
+  dirty = false;
+
+  integrate();
+  compute_line_of_sight();
+  compute_directions();
+
+  return true;
+}
+
+bool FlowField::can_step(const sf::Vector2i& cell,
+                         const sf::Vector2i& offset) const {
+  auto neighbor = cell + offset;
+  if (!contains(neighbor) || blocked[get_index(neighbor)]) {
+    return false;
+  }
+
+  if (offset.x != 0 && offset.y != 0) {
+    return !blocked[get_index(cell + sf::Vector2i{offset.x, 0})] &&
+           !blocked[get_index(cell + sf::Vector2i{0, offset.y})];
+  }
+
+  return true;
+}
+
+void FlowField::integrate() {
+  std::fill(costs.begin(), costs.end(), UNREACHABLE);
+
+  // Dial's algorithm: step costs are at most 3, so four buckets indexed by
+  // cost modulo four hold every queued cell
+  costs[get_index(*target_cell)] = 0;
+  buckets[0].push_back(get_index(*target_cell));
+  size_t num_queued = 1;
+
+  for (uint32_t cost = 0; num_queued > 0; ++cost) {
+    auto& bucket = buckets[cost % buckets.size()];
+
+    // Steps cost at least 2, so this bucket doesn't grow while it's scanned
+    for (size_t index : bucket) {
+      --num_queued;
+
+      // Skip cells that were queued again with a lower cost
+      if (costs[index] != cost) {
+        continue;
+      }
+
+      sf::Vector2i cell{static_cast<int>(index % size.x),
+                        static_cast<int>(index / size.x)};
+      for (const auto& offset : NEIGHBOR_OFFSETS) {
+        if (!can_step(cell, offset)) {
+          continue;
+        }
+
+        uint32_t neighbor_cost =
+            cost + (offset.x != 0 && offset.y != 0 ? 3 : 2);
+        size_t neighbor_index = get_index(cell + offset);
+        if (neighbor_cost < costs[neighbor_index]) {
+          costs[neighbor_index] = neighbor_cost;
+          buckets[neighbor_cost % buckets.size()].push_back(neighbor_index);
+          ++num_queued;
+        }
+      }
+    }
+
+    bucket.clear();
+  }
+}
+
+void FlowField::compute_line_of_sight() {
+  const auto& target = *target_cell;
+
+  std::fill(visible.begin(), visible.end(), 0);
+  visible[get_index(target)] = 1;
+
+  // A cell sees the target if it's open and the cells it looks through next
+  // see the target. Those cells are one ring closer to the target, so visiting
+  // rings in order of Chebyshev distance computes them first. Lines passing
+  // between two cells need both to see the target, which errs toward following
+  // the flow near obstacle corners.
+  auto visit = [&](const sf::Vector2i& cell) {
+    size_t index = get_index(cell);
+    if (blocked[index]) {
+      return;
+    }
+
+    sf::Vector2i delta = target - cell;
+    int abs_x = std::abs(delta.x);
+    int abs_y = std::abs(delta.y);
+    sf::Vector2i step{sign(delta.x), sign(delta.y)};
+
+    bool sees_target;
+    if (abs_x == abs_y) {
+      sees_target = visible[get_index(cell + step)];
+    } else if (abs_x > abs_y) {
+      sees_target = visible[get_index(cell + sf::Vector2i{step.x, 0})] &&
+                    (step.y == 0 || visible[get_index(cell + step)]);
+    } else {
+      sees_target = visible[get_index(cell + sf::Vector2i{0, step.y})] &&
+                    (step.x == 0 || visible[get_index(cell + step)]);
+    }
+    visible[index] = sees_target;
+  };
+
+  int max_radius = std::max({target.x, size.x - 1 - target.x, target.y,
+                             size.y - 1 - target.y});
+  for (int radius = 1; radius <= max_radius; ++radius) {
+    int min_x = std::max(target.x - radius, 0);
+    int max_x = std::min(target.x + radius, size.x - 1);
+    int min_y = std::max(target.y - radius + 1, 0);
+    int max_y = std::min(target.y + radius - 1, size.y - 1);
+
+    // Top and bottom rows of the ring
+    for (int y : {target.y - radius, target.y + radius}) {
+      if (y >= 0 && y < size.y) {
+        for (int x = min_x; x <= max_x; ++x) {
+          visit({x, y});
+        }
+      }
+    }
+
+    // Left and right columns of the ring, excluding corners
+    for (int x : {target.x - radius, target.x + radius}) {
+      if (x >= 0 && x < size.x) {
+        for (int y = min_y; y <= max_y; ++y) {
+          visit({x, y});
+        }
+      }
+    }
+  }
+}
+
+void FlowField::compute_directions() {
+  for (int y = 0; y < size.y; ++y) {
+    for (int x = 0; x < size.x; ++x) {
+      sf::Vector2i cell{x, y};
+      size_t index = get_index(cell);
+
+      directions[index] = {0.f, 0.f};
+      if (visible[index]) {
+        continue;
+      }
+
+      // Walk toward the cheapest reachable neighbor. Blocked cells have no
+      // cost of their own, so zombies inside them walk out.
+      uint32_t best_cost = costs[index];
+      for (const auto& offset : NEIGHBOR_OFFSETS) {
+        if (!contains(cell + offset)) {
+          continue;
+        }
+
+        size_t neighbor_index = get_index(cell + offset);
+        bool diagonal = offset.x != 0 && offset.y != 0;
+        if (costs[neighbor_index] < best_cost &&
+            (!diagonal ||
+             (!blocked[get_index(cell + sf::Vector2i{offset.x, 0})] &&
+              !blocked[get_index(cell + sf::Vector2i{0, offset.y})]))) {
+          best_cost = costs[neighbor_index];
+          directions[index] = sf::Vector2f{offset}.normalized();
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+
+/// Grid over the map that gives the direction to walk toward a target around
+/// blocked cells.
+///
+/// Each update runs three O(cells) passes:
+/// 1. Integration: path costs to the target cell, using a bucket queue with
+///    orthogonal steps costing 2 and diagonal steps costing 3.
+/// 2. Line of sight: cells that can see the target cell. Directions toward the
+///    target are propagated outward from it in rings.
+/// 3. Directions: unit vectors toward the cheapest neighbor. Cells with line of
+///    sight and unreachable cells get zero instead, which means "head straight
+///    for the target".
+class FlowField {
+ public:
+  /// Cell side length in pixels.
+  static constexpr float CELL_SIZE = 50.f;
+
+  /// Constructs a FlowField covering the map with no blocked cells.
+  FlowField();
+
+  /// Returns the grid size in cells.
+  const sf::Vector2i& get_size() const { return size; }
+
+  /// Returns the cell containing the given position, clamped to the grid.
+  ///
+  /// @param position Position in pixels.
+  sf::Vector2i get_cell(const sf::Vector2f& position) const {
+    // Truncation only differs from floor() for positions left of or above the
+    // map, which clamp to the first cell either way
+    sf::Vector2f offset = (position - MAP_BOUNDS.position) / CELL_SIZE;
+    return {std::clamp(static_cast<int>(offset.x), 0, size.x - 1),
+            std::clamp(static_cast<int>(offset.y), 0, size.y - 1)};
+  }
+
+  /// Returns whether the given cell is blocked.
+  ///
+  /// @param cell The cell.
+  bool is_blocked(const sf::Vector2i& cell) const {
+    return blocked[get_index(cell)];
+  }
+
+  /// Sets whether the given cell is blocked. The field is recomputed on the
+  /// next update().
+  ///
+  /// @param cell The cell.
+  /// @param blocked Whether the cell is blocked.
+  void set_blocked(const sf::Vector2i& cell, bool blocked);
+
+  /// Recomputes the field if the target moved to another cell or blocked
+  /// cells changed since the last update.
+  ///
+  /// @param target Target position in pixels.
+  /// @return True if the field was recomputed.
+  bool update(const sf::Vector2f& target);
+
+  /// Returns the direction to walk from the given position. It's a unit
+  /// vector, or zero if the position has line of sight to the target or can't
+  /// reach it.
+  ///
+  /// @param position Position in pixels.
+  const sf::Vector2f& get_direction(const sf::Vector2f& position) const {
+    return directions[get_index(get_cell(position))];
+  }
+
+ private:
+  /// Path cost of cells that can't reach the target.
+  static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+  sf::Vector2i size;
+
+  std::vector<uint8_t> blocked;
+  std::vector<uint32_t> costs;
+  std::vector<uint8_t> visible;
+  std::vector<sf::Vector2f> directions;
+
+  /// Integration bucket queue indexed by cost modulo the bucket count.
+  std::array<std::vector<size_t>, 4> buckets;
+
+  std::optional<sf::Vector2i> target_cell;
+  bool dirty = true;
+
+  /// Returns the index of the given cell in the per-cell arrays.
+  ///
+  /// @param cell The cell.
+  size_t get_index(const sf::Vector2i& cell) const {
+    return static_cast<size_t>(cell.y) * size.x + cell.x;
+  }
+
+  /// Returns whether the given cell is within the grid.
+  ///
+  /// @param cell The cell.
+  bool contains(const sf::Vector2i& cell) const {
+    return cell.x >= 0 && cell.x < size.x && cell.y >= 0 && cell.y < size.y;
+  }
+
+  /// Returns whether a step from the given cell by the given offset is
+  /// allowed. Diagonal steps may not cut blocked corners.
+  ///
+  /// @param cell The cell.
+  /// @param offset Offset to a neighboring cell.
+  bool can_step(const sf::Vector2i& cell, const sf::Vector2i& offset) const;
+
+  /// Computes path costs from every cell to the target cell.
+  void integrate();
+
+  /// Computes which cells have line of sight to the target cell.
+  void compute_line_of_sight();
+
+  /// Computes the direction to walk from every cell.
+  void compute_directions();
+};
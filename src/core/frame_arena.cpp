@@ -0,0 +1,66 @@
+// Copyright (c) Tyler Veness
+
+#include "frame_arena.hpp"
+
+#include <stddef.h>
+
+#include <bit>
+#include <memory>
+#include <new>
+
+FrameArena::FrameArena(size_t capacity)
+    : buffer{std::make_unique_for_overwrite<std::byte[]>(capacity)},
+      capacity{capacity} {}
+
+FrameArena::~FrameArena() {
+  free_overflows();
+}
+
+void FrameArena::reset() {
+  if (!overflows.empty()) {
+    // Grow the buffer to fit everything the last frame allocated
+    capacity = std::bit_ceil(offset + overflow_bytes);
+    buffer = std::make_unique_for_overwrite<std::byte[]>(capacity);
+    free_overflows();
+  }
+
+  offset = 0;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+  void* data = buffer.get() + offset;
+  size_t space = capacity - offset;
+  if (std::align(alignment, bytes, data, space)) {
+    offset = capacity - space + bytes;
+    return data;
+  }
+
+  // Overflows go through the global operator new so the allocation tracker
+  // sees them. Only over-aligned ones need the aligned overload.
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    data = ::operator new(bytes);
+  } else {
+    data = ::operator new(bytes, std::align_val_t{alignment});
+  }
+  overflows.emplace_back(data, bytes, alignment);
+  overflow_bytes += bytes + alignment;
+  return data;
+}
+
+void FrameArena::free_overflows() {
+  for (const auto& overflow : overflows) {
+    if (overflow.alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(overflow.data, overflow.bytes);
+    } else {
+      ::operator delete(overflow.data, overflow.bytes,
+                        std::align_val_t{overflow.alignment});
+    }
+  }
+  overflows.clear();
+  overflow_bytes = 0;
+}
+
+FrameArena& global_frame_arena() {
+  static FrameArena frame_arena;
+  return frame_arena;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/// Bump allocator for data that only lives until the end of the frame.
+///
+/// Allocations bump an offset into one buffer, deallocation does nothing, and
+/// reset() rewinds the offset. Use it through std::pmr containers, and
+/// destroy them before the next reset.
+///
+/// If a frame runs out of buffer, the rest of its allocations come from the
+/// heap, and the next reset() replaces the buffer with one big enough for the
+/// whole frame. The buffer grows to the largest frame's usage, after which
+/// frames make no heap allocations.
+///
+/// It isn't synchronized, so only use it from the simulation thread, or from
+/// jobs that are ordered by their dependencies.
+class FrameArena : public std::pmr::memory_resource {
+ public:
+  /// Constructs a FrameArena.
+  ///
+  /// @param capacity Initial buffer size in bytes.
+  explicit FrameArena(size_t capacity = 64 * 1024);
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  ~FrameArena() override;
+
+  /// Frees everything allocated since the last reset.
+  void reset();
+
+  /// Returns the buffer size in bytes.
+  size_t get_capacity() const { return capacity; }
+
+  /// Returns the bytes allocated since the last reset, including alignment
+  /// padding.
+  size_t get_used_bytes() const { return offset + overflow_bytes; }
+
+ private:
+  /// Heap allocation made after the buffer ran out.
+  struct Overflow {
+    void* data;
+    size_t bytes;
+    size_t alignment;
+  };
+
+  std::unique_ptr<std::byte[]> buffer;
+  size_t capacity;
+  size_t offset = 0;
+
+  std::vector<Overflow> overflows;
+  size_t overflow_bytes = 0;
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+
+  void do_deallocate(void*, size_t, size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  /// Returns overflow allocations to the heap.
+  void free_overflows();
+};
+
+/// Returns the application-wide frame arena. The main loop resets it at the
+/// end of every frame.
+FrameArena& global_frame_arena();
@@ -0,0 +1,48 @@
+// Copyright (c) Tyler Veness
+
+#include "globals.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <random>
+#include <utility>
+
+#include "random.hpp"
+
+namespace {
+
+/// Application-wide random number streams.
+struct GlobalRandom {
+  std::array<Random, NUM_RANDOM_STREAMS> streams;
+
+  /// Reseeds every stream.
+  ///
+  /// @param seed The seed.
+  void reseed(uint64_t seed) {
+    for (size_t i = 0; i < streams.size(); ++i) {
+      streams[i] = Random{seed, i};
+    }
+  }
+};
+
+GlobalRandom& get_global_random() {
+  static GlobalRandom global_random = [] {
+    GlobalRandom global_random;
+    std::random_device device;
+    global_random.reseed(static_cast<uint64_t>(device()) << 32 | device());
+    return global_random;
+  }();
+  return global_random;
+}
+
+}  // namespace
+
+Random& global_random(RandomStream stream) {
+  return get_global_random().streams[std::to_underlying(stream)];
+}
+
+void seed_global_random(uint64_t seed) {
+  get_global_random().reseed(seed);
+}
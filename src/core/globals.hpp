@@ -0,0 +1,36 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include "random.hpp"
+
+/// Application-wide random number streams, one per system. Each system's
+/// draws don't depend on how many numbers the others drew, so a seeded run
+/// stays reproducible as systems change.
+enum class RandomStream : uint8_t {
+  /// Weapon inaccuracy.
+  BULLET_SPREAD,
+  /// Directions of lasers split off on kills.
+  LASER_SPLIT,
+  /// Zombie wave types and positions.
+  ZOMBIE_SPAWN,
+  /// Weapon crate types and positions.
+  WEAPON_CRATE_SPAWN
+};
+
+/// Number of application-wide random number streams.
+inline constexpr int NUM_RANDOM_STREAMS = 4;
+
+/// Returns the application-wide random number generator for the given stream.
+/// The streams aren't synchronized, so only use each from one thread at a
+/// time.
+///
+/// @param stream The stream.
+Random& global_random(RandomStream stream);
+
+/// Reseeds every application-wide random number stream.
+///
+/// @param seed The seed.
+void seed_global_random(uint64_t seed);
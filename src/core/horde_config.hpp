@@ -0,0 +1,86 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+
+/// How the zombie cap grows over a game.
+enum class HordeRamp : uint8_t {
+  /// Grows by one zombie per 100 XP the player earns.
+  EXPERIENCE,
+  /// Grows linearly with simulation time over the ramp duration.
+  LINEAR,
+  /// Grows quadratically with simulation time over the ramp duration, so the
+  /// horde stays small early on and surges at the end.
+  QUADRATIC,
+  /// Starts at the maximum.
+  IMMEDIATE
+};
+
+/// Returns the ramp with the given name, if any.
+///
+/// @param name Lowercase ramp name, like "linear".
+constexpr std::optional<HordeRamp> horde_ramp_from_name(std::string_view name) {
+  if (name == "experience") {
+    return HordeRamp::EXPERIENCE;
+  } else if (name == "linear") {
+    return HordeRamp::LINEAR;
+  } else if (name == "quadratic") {
+    return HordeRamp::QUADRATIC;
+  } else if (name == "immediate") {
+    return HordeRamp::IMMEDIATE;
+  } else {
+    return std::nullopt;
+  }
+}
+
+/// Zombie horde size limits.
+struct HordeConfig {
+  /// Zombie cap at the start of a game.
+  static constexpr uint32_t MIN_ZOMBIES = 10;
+
+  /// Zombie cap at the end of the ramp. Zombie storage is reserved for this
+  /// many up front.
+  uint32_t max_zombies = 1000;
+
+  /// How the zombie cap grows.
+  HordeRamp ramp = HordeRamp::EXPERIENCE;
+
+  /// Seconds of simulation time for time-based ramps to reach the maximum.
+  float ramp_duration = 300.f;
+
+  /// Maximum number of zombies spawned at once.
+  uint32_t wave_size = 1;
+
+  /// Returns the current zombie cap.
+  ///
+  /// @param xp The player's accrued experience.
+  /// @param elapsed_time Seconds of simulation time since the game started.
+  uint32_t get_cap(uint32_t xp, float elapsed_time) const {
+    uint32_t min_zombies = std::min(MIN_ZOMBIES, max_zombies);
+    float progress =
+        ramp_duration > 0.f
+            ? std::clamp(elapsed_time / ramp_duration, 0.f, 1.f)
+            : 1.f;
+
+    switch (ramp) {
+      case HordeRamp::EXPERIENCE:
+        return std::min(xp / 100 + min_zombies, max_zombies);
+      case HordeRamp::LINEAR:
+        return min_zombies + static_cast<uint32_t>(
+                                 progress * (max_zombies - min_zombies));
+      case HordeRamp::QUADRATIC:
+        return min_zombies +
+               static_cast<uint32_t>(progress * progress *
+                                     (max_zombies - min_zombies));
+      case HordeRamp::IMMEDIATE:
+        return max_zombies;
+    }
+
+    return max_zombies;
+  }
+};
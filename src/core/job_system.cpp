@@ -0,0 +1,221 @@
+// Copyright (c) Tyler Veness
+
+#include "job_system.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "phase.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
+
+uint32_t JobGraph::add_job(Phase phase, void* context, JobFunction function,
+                           std::initializer_list<uint32_t> dependencies) {
+  auto id = static_cast<uint32_t>(jobs.size());
+  jobs.push_back({phase, context, function,
+                  static_cast<uint32_t>(dependencies.size()), NONE});
+
+  for (uint32_t dependency : dependencies) {
+    auto& job = jobs[dependency];
+    edges.push_back({id, job.first_dependent});
+    job.first_dependent = static_cast<uint32_t>(edges.size() - 1);
+  }
+
+  return id;
+}
+
+JobSystem::JobSystem(int num_threads)
+    : queues(static_cast<size_t>(std::max(num_threads, 1))) {
+  for (size_t i = 1; i < queues.size(); ++i) {
+    workers.emplace_back([this, i] { worker_main(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::scoped_lock lock{mutex};
+    stopping = true;
+  }
+  work_cv.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void JobSystem::run(const JobGraph& graph) {
+  size_t num_jobs = graph.jobs.size();
+  if (num_jobs == 0) {
+    return;
+  }
+
+  // Only reallocates when the graph grows
+  if (remaining_dependencies_size < num_jobs) {
+    remaining_dependencies =
+        std::make_unique<std::atomic<uint32_t>[]>(num_jobs);
+    remaining_dependencies_size = num_jobs;
+  }
+  for (auto& queue : queues) {
+    if (queue.jobs.size() < num_jobs) {
+      queue.jobs.resize(num_jobs);
+    }
+    queue.head = 0;
+    queue.tail = 0;
+  }
+
+  // Jobs without dependencies start in the calling thread's queue, and the
+  // workers steal them from there
+  size_t num_ready = 0;
+  for (size_t i = 0; i < num_jobs; ++i) {
+    uint32_t num_dependencies = graph.jobs[i].num_dependencies;
+    remaining_dependencies[i].store(num_dependencies,
+                                    std::memory_order_relaxed);
+    if (num_dependencies == 0) {
+      queues[0].jobs[queues[0].tail++] = static_cast<uint32_t>(i);
+      ++num_ready;
+    }
+  }
+  remaining_jobs.store(num_jobs, std::memory_order_relaxed);
+  ready_jobs.store(num_ready, std::memory_order_relaxed);
+
+  {
+    std::scoped_lock lock{mutex};
+    this->graph = &graph;
+    busy_workers = static_cast<int>(workers.size());
+    ++generation;
+  }
+  work_cv.notify_all();
+
+  run_jobs(0);
+
+  // Every worker checks in before returning so none can still be reading this
+  // graph's state when the next one starts
+  std::unique_lock lock{mutex};
+  done_cv.wait(lock, [&] { return busy_workers == 0; });
+}
+
+void JobSystem::push(size_t thread, uint32_t job) {
+  {
+    auto& queue = queues[thread];
+    std::scoped_lock lock{queue.mutex};
+
+    // Counting the job before it's visible keeps a thief that pops it right
+    // away from decrementing the count below zero
+    ready_jobs.fetch_add(1);
+    queue.jobs[queue.tail++] = job;
+  }
+
+  // Either this sees a waiting thread, or that thread sees the job before it
+  // waits
+  if (waiting_threads.load() > 0) {
+    std::scoped_lock lock{mutex};
+    job_cv.notify_one();
+  }
+}
+
+std::optional<uint32_t> JobSystem::pop(size_t thread) {
+  {
+    auto& queue = queues[thread];
+    std::scoped_lock lock{queue.mutex};
+    if (queue.head < queue.tail) {
+      ready_jobs.fetch_sub(1);
+      return queue.jobs[--queue.tail];
+    }
+  }
+
+  for (size_t i = 1; i < queues.size(); ++i) {
+    auto& queue = queues[(thread + i) % queues.size()];
+    std::scoped_lock lock{queue.mutex};
+    if (queue.head < queue.tail) {
+      ready_jobs.fetch_sub(1);
+      return queue.jobs[queue.head++];
+    }
+  }
+
+  return std::nullopt;
+}
+
+void JobSystem::run_jobs(size_t thread) {
+  TRACE_SCOPE("job system jobs");
+
+  while (remaining_jobs.load(std::memory_order_acquire) > 0) {
+    auto index = pop(thread);
+    if (!index) {
+      // Wait until a running job makes another one ready or the graph is done
+      std::unique_lock lock{mutex};
+      waiting_threads.fetch_add(1);
+      job_cv.wait(lock, [&] {
+        return ready_jobs.load() > 0 ||
+               remaining_jobs.load(std::memory_order_acquire) == 0;
+      });
+      waiting_threads.fetch_sub(1);
+      continue;
+    }
+
+    const auto& job = graph->jobs[*index];
+    {
+      ScopedPhaseTimer timer{job.phase};
+      job.function(job.context);
+    }
+
+    // Queue dependents this job was the last dependency of. Running them on
+    // this thread next keeps the data this job touched in cache.
+    for (uint32_t edge = job.first_dependent; edge != JobGraph::NONE;
+         edge = graph->edges[edge].next) {
+      uint32_t dependent = graph->edges[edge].dependent;
+      if (remaining_dependencies[dependent].fetch_sub(
+              1, std::memory_order_acq_rel) == 1) {
+        push(thread, dependent);
+      }
+    }
+
+    if (remaining_jobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::scoped_lock lock{mutex};
+      job_cv.notify_all();
+    }
+  }
+}
+
+void JobSystem::worker_main(size_t thread) {
+  uint64_t last_generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock{mutex};
+      work_cv.wait(lock,
+                   [&] { return stopping || generation != last_generation; });
+      if (stopping) {
+        return;
+      }
+      last_generation = generation;
+    }
+
+    run_jobs(thread);
+
+    bool last_worker;
+    {
+      std::scoped_lock lock{mutex};
+      last_worker = --busy_workers == 0;
+    }
+    if (last_worker) {
+      done_cv.notify_one();
+    }
+  }
+}
+
+JobSystem& global_job_system() {
+  // The frame graph is only a few jobs wide, so more threads would only wait
+  constexpr unsigned int MAX_THREADS = 4;
+
+  static JobSystem job_system{static_cast<int>(
+      std::clamp(std::thread::hardware_concurrency(), 1u, MAX_THREADS))};
+  return job_system;
+}
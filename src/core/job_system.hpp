@@ -0,0 +1,183 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "phase.hpp"
+
+/// Jobs and the order they depend on, run by a JobSystem.
+///
+/// Jobs can only depend on jobs added before them, so graphs can't have
+/// cycles.
+class JobGraph {
+ public:
+  /// Constructs an empty JobGraph.
+  ///
+  /// @param resource Memory resource for the graph's storage.
+  explicit JobGraph(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : jobs{resource}, edges{resource} {}
+
+  /// Adds a job.
+  ///
+  /// @param phase Phase the job's time is attributed to. Jobs that can run at
+  ///   the same time must have different phases.
+  /// @param func Callable the job runs. It must outlive the graph's run.
+  /// @param dependencies IDs of jobs that must finish before this one starts.
+  /// @return The job's ID.
+  template <typename F>
+  uint32_t add(Phase phase, F& func,
+               std::initializer_list<uint32_t> dependencies = {}) {
+    return add_job(
+        phase, &func, [](void* context) { (*static_cast<F*>(context))(); },
+        dependencies);
+  }
+
+  /// Returns the number of jobs.
+  size_t size() const { return jobs.size(); }
+
+ private:
+  friend class JobSystem;
+
+  using JobFunction = void (*)(void* context);
+
+  /// Marks the end of a job's list of dependents.
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  struct Job {
+    Phase phase;
+    void* context;
+    JobFunction function;
+    uint32_t num_dependencies;
+
+    /// First edge in the list of jobs that depend on this one.
+    uint32_t first_dependent;
+  };
+
+  /// Entry in a job's singly linked list of dependents.
+  struct Edge {
+    uint32_t dependent;
+    uint32_t next;
+  };
+
+  std::pmr::vector<Job> jobs;
+  std::pmr::vector<Edge> edges;
+
+  /// Adds a job.
+  ///
+  /// @param phase Phase the job's time is attributed to.
+  /// @param context Callable passed to function.
+  /// @param function Function that runs the job.
+  /// @param dependencies IDs of jobs that must finish before this one starts.
+  /// @return The job's ID.
+  uint32_t add_job(Phase phase, void* context, JobFunction function,
+                   std::initializer_list<uint32_t> dependencies);
+};
+
+/// Fixed-size set of threads that run job graphs with work stealing.
+///
+/// Each thread has its own queue of ready jobs. Threads take jobs from the
+/// back of their own queue, where the jobs they just made ready are, and
+/// steal from the front of other threads' queues when theirs is empty. Each
+/// job's time is added to its phase in the application-wide profiler.
+class JobSystem {
+ public:
+  /// Constructs a JobSystem.
+  ///
+  /// @param num_threads Number of threads running each graph, including the
+  ///   calling thread. One runs graphs serially on the calling thread.
+  explicit JobSystem(int num_threads);
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  ~JobSystem();
+
+  /// Returns the number of threads running each graph, including the calling
+  /// thread.
+  int get_thread_count() const { return static_cast<int>(workers.size()) + 1; }
+
+  /// Runs every job in a graph, each after the jobs it depends on, and blocks
+  /// until all are done.
+  ///
+  /// @param graph The graph.
+  void run(const JobGraph& graph);
+
+ private:
+  /// Ready jobs of one thread. Each job is queued once per graph, so the
+  /// buffer is sized to the graph and never wraps.
+  struct WorkQueue {
+    std::mutex mutex;
+    std::vector<uint32_t> jobs;
+
+    /// Index of the oldest job, which thieves take.
+    size_t head = 0;
+
+    /// Index past the newest job, which the owner takes.
+    size_t tail = 0;
+  };
+
+  /// Queues of the calling thread, then each worker.
+  std::vector<WorkQueue> queues;
+
+  std::vector<std::thread> workers;
+
+  std::mutex mutex;
+  std::condition_variable work_cv;
+  std::condition_variable job_cv;
+  std::condition_variable done_cv;
+
+  // Current graph, guarded by mutex
+  const JobGraph* graph = nullptr;
+  uint64_t generation = 0;
+  int busy_workers = 0;
+  bool stopping = false;
+
+  /// Unfinished dependencies of each job in the current graph.
+  std::unique_ptr<std::atomic<uint32_t>[]> remaining_dependencies;
+  size_t remaining_dependencies_size = 0;
+
+  std::atomic<size_t> remaining_jobs = 0;
+  /// Jobs queued but not popped yet. A job is counted before it's queued, so
+  /// this never drops below zero.
+  std::atomic<size_t> ready_jobs = 0;
+
+  /// Threads waiting for a job to become ready. Only modified with mutex held.
+  std::atomic<int> waiting_threads = 0;
+
+  /// Queues a ready job.
+  ///
+  /// @param thread Index of the queue.
+  /// @param job The job's ID.
+  void push(size_t thread, uint32_t job);
+
+  /// Takes a ready job from a thread's own queue, or steals one.
+  ///
+  /// @param thread Index of the thread's queue.
+  std::optional<uint32_t> pop(size_t thread);
+
+  /// Runs jobs of the current graph until all are done.
+  ///
+  /// @param thread Index of the thread's queue.
+  void run_jobs(size_t thread);
+
+  /// Worker thread body.
+  ///
+  /// @param thread Index of the worker's queue.
+  void worker_main(size_t thread);
+};
+
+/// Returns the application-wide job system.
+JobSystem& global_job_system();
@@ -0,0 +1,40 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <SFML/System/Vector2.hpp>
+
+/// Seconds a laser streak stays visible after its shot resolves.
+constexpr float LASER_STREAK_LIFETIME = 0.25f;
+
+/// Number of lower-damage lasers a laser splits into when it kills a zombie.
+constexpr size_t LASER_SPLIT_COUNT = 5;
+
+/// Laser shot waiting to be resolved as a hitscan ray.
+struct LaserRay {
+  /// Ray origin.
+  sf::Vector2f origin;
+
+  /// Ray direction as a unit vector.
+  sf::Vector2f direction;
+
+  /// Maximum distance the laser reaches.
+  float range;
+
+  /// Damage dealt to the first zombie hit.
+  int damage;
+};
+
+/// Visual trace of a resolved laser. It has no effect on the simulation.
+struct LaserStreak {
+  /// Where the laser started.
+  sf::Vector2f start;
+
+  /// Where the laser stopped, either at a zombie or at its range.
+  sf::Vector2f end;
+
+  /// Seconds since the laser resolved.
+  float age = 0.f;
+};
@@ -0,0 +1,88 @@
+// Copyright (c) Tyler Veness
+
+#include "net_protocol.hpp"
+
+#include <stdint.h>
+
+#include <optional>
+#include <utility>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "bit_stream.hpp"
+#include "net_state.hpp"
+#include "weapon_type.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Bits of a MessageType.
+constexpr int MESSAGE_TYPE_BITS = 2;
+
+/// Bits of a weapon type.
+constexpr int WEAPON_TYPE_BITS = 3;
+
+/// Writes a direction component as -1, 0, or 1.
+///
+/// @param component The component.
+/// @param writer The writer.
+void write_direction(float component, BitWriter& writer) {
+  writer.write_signed(component > 0.f ? 1 : component < 0.f ? -1 : 0, 2, 2);
+}
+
+}  // namespace
+
+void write_message_header(MessageType type, BitWriter& writer) {
+  writer.write(PROTOCOL_ID, 32);
+  writer.write(std::to_underlying(type), MESSAGE_TYPE_BITS);
+}
+
+std::optional<MessageType> read_message_header(BitReader& reader) {
+  if (reader.read(32) != PROTOCOL_ID) {
+    return std::nullopt;
+  }
+
+  auto type = static_cast<MessageType>(reader.read(MESSAGE_TYPE_BITS));
+  if (reader.has_overflowed()) {
+    return std::nullopt;
+  }
+  return type;
+}
+
+void write_player_input(const PlayerInput& input, BitWriter& writer) {
+  write_direction(input.direction.x, writer);
+  write_direction(input.direction.y, writer);
+  writer.write_bool(input.sprint);
+  writer.write_bool(input.fire);
+  writer.write(quantize_position(input.aim_target.x), POSITION_BITS);
+  writer.write(quantize_position(input.aim_target.y), POSITION_BITS);
+
+  writer.write_bool(input.weapon.has_value());
+  if (input.weapon) {
+    writer.write(static_cast<uint32_t>(std::to_underlying(*input.weapon)),
+                 WEAPON_TYPE_BITS);
+  }
+}
+
+std::optional<PlayerInput> read_player_input(BitReader& reader) {
+  PlayerInput input;
+  input.direction.x = static_cast<float>(reader.read_signed(2, 2));
+  input.direction.y = static_cast<float>(reader.read_signed(2, 2));
+  input.sprint = reader.read_bool();
+  input.fire = reader.read_bool();
+  input.aim_target = {dequantize_position(reader.read(POSITION_BITS)),
+                      dequantize_position(reader.read(POSITION_BITS))};
+
+  if (reader.read_bool()) {
+    uint32_t weapon = reader.read(WEAPON_TYPE_BITS);
+    if (weapon >= NUM_WEAPONS) {
+      return std::nullopt;
+    }
+    input.weapon = static_cast<WeaponType>(weapon);
+  }
+
+  if (reader.has_overflowed()) {
+    return std::nullopt;
+  }
+  return input;
+}
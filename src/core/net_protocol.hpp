@@ -0,0 +1,72 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "bit_stream.hpp"
+#include "net_state.hpp"
+#include "world.hpp"
+
+// Every datagram starts with PROTOCOL_ID and a MessageType, followed by:
+//
+// * CONNECT and DISCONNECT: nothing.
+// * INPUT: the newest snapshot tick the client has, if any, then the input.
+// * SNAPSHOT: the tick, the baseline tick the delta was written against, if
+//   any, then the delta from write_net_state_delta().
+
+/// Identifies datagrams of this protocol version.
+constexpr uint32_t PROTOCOL_ID = 0x4141'5201;
+
+/// Default server UDP port.
+constexpr uint16_t DEFAULT_SERVER_PORT = 47'000;
+
+/// Server ticks per second.
+constexpr int SERVER_TICK_RATE = 60;
+
+/// Number of past states the server keeps as delta baselines. Clients whose
+/// newest acknowledged state is older get a full snapshot instead.
+constexpr uint32_t NET_STATE_HISTORY = 64;
+
+/// Datagram type.
+enum class MessageType : uint8_t {
+  /// Client asks to join.
+  CONNECT,
+
+  /// Client leaves.
+  DISCONNECT,
+
+  /// Client input and acknowledgement.
+  INPUT,
+
+  /// Server state.
+  SNAPSHOT
+};
+
+/// Writes a datagram header.
+///
+/// @param type Message type.
+/// @param writer The writer.
+void write_message_header(MessageType type, BitWriter& writer);
+
+/// Reads a datagram header.
+///
+/// @param reader The reader.
+/// @return The message type, or nothing if the datagram isn't from this
+///   protocol.
+std::optional<MessageType> read_message_header(BitReader& reader);
+
+/// Writes player input. Directions are rounded to -1, 0, or 1 per axis and
+/// the aim target is quantized like positions.
+///
+/// @param input The input.
+/// @param writer The writer.
+void write_player_input(const PlayerInput& input, BitWriter& writer);
+
+/// Reads player input written by write_player_input().
+///
+/// @param reader The reader.
+/// @return The input, or nothing if it was malformed.
+std::optional<PlayerInput> read_player_input(BitReader& reader);
@@ -0,0 +1,233 @@
+// Copyright (c) Tyler Veness
+
+#include "net_state.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bit_stream.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Bits of a field difference small enough to take the short form.
+constexpr int SMALL_DELTA_BITS = 4;
+
+/// Returns a value rounded and clamped to an unsigned field.
+///
+/// @param value The value.
+/// @param num_bits Field width in bits.
+uint32_t quantize(float value, int num_bits) {
+  float max = static_cast<float>((uint64_t{1} << num_bits) - 1);
+  return static_cast<uint32_t>(std::clamp(std::round(value), 0.f, max));
+}
+
+/// Writes an entity's fields as differences from a baseline entity.
+///
+/// @param baseline Fields of the baseline entity.
+/// @param entity Fields of the entity.
+/// @param field_bits Bit width of each field.
+/// @param writer The writer.
+template <size_t N>
+void write_field_deltas(const std::array<uint32_t, N>& baseline,
+                        const std::array<uint32_t, N>& entity,
+                        const std::array<int, N>& field_bits,
+                        BitWriter& writer) {
+  bool changed = baseline != entity;
+  writer.write_bool(changed);
+  if (!changed) {
+    return;
+  }
+
+  for (size_t i = 0; i < N; ++i) {
+    writer.write_bool(entity[i] != baseline[i]);
+    if (entity[i] != baseline[i]) {
+      // Wraps for 32-bit fields, which the reader undoes
+      writer.write_signed(static_cast<int32_t>(entity[i] - baseline[i]),
+                          SMALL_DELTA_BITS, std::min(field_bits[i] + 1, 32));
+    }
+  }
+}
+
+/// Reads fields written by write_field_deltas().
+///
+/// @param baseline Fields of the baseline entity.
+/// @param field_bits Bit width of each field.
+/// @param reader The reader.
+template <size_t N>
+std::array<uint32_t, N> read_field_deltas(
+    const std::array<uint32_t, N>& baseline,
+    const std::array<int, N>& field_bits, BitReader& reader) {
+  auto entity = baseline;
+  if (!reader.read_bool()) {
+    return entity;
+  }
+
+  for (size_t i = 0; i < N; ++i) {
+    if (reader.read_bool()) {
+      entity[i] += static_cast<uint32_t>(reader.read_signed(
+          SMALL_DELTA_BITS, std::min(field_bits[i] + 1, 32)));
+    }
+  }
+  return entity;
+}
+
+/// Writes an entity list as a delta against a baseline list.
+///
+/// @param baseline The baseline list.
+/// @param entities The list.
+/// @param field_bits Bit width of each field.
+/// @param writer The writer.
+template <size_t N>
+void write_list_delta(std::span<const NetEntity<N>> baseline,
+                      std::span<const NetEntity<N>> entities,
+                      const std::array<int, N>& field_bits,
+                      BitWriter& writer) {
+  // Entities still around are in the same order as in the baseline, and new
+  // ones follow them
+  size_t i = 0;
+  for (const auto& baseline_entity : baseline) {
+    bool kept = i < entities.size() && entities[i].id == baseline_entity.id;
+    writer.write_bool(kept);
+    if (kept) {
+      write_field_deltas(baseline_entity.fields, entities[i].fields,
+                         field_bits, writer);
+      ++i;
+    }
+  }
+
+  writer.write_varint(static_cast<uint32_t>(entities.size() - i));
+  uint32_t previous_id = baseline.empty() ? 0 : baseline.back().id;
+  for (; i < entities.size(); ++i) {
+    writer.write_varint(entities[i].id - previous_id);
+    previous_id = entities[i].id;
+    for (size_t field = 0; field < N; ++field) {
+      writer.write(entities[i].fields[field], field_bits[field]);
+    }
+  }
+}
+
+/// Reads a list written by write_list_delta().
+///
+/// @param baseline The baseline list.
+/// @param field_bits Bit width of each field.
+/// @param reader The reader.
+/// @param entities The list.
+/// @return False if the list was malformed.
+template <size_t N>
+bool read_list_delta(std::span<const NetEntity<N>> baseline,
+                     const std::array<int, N>& field_bits, BitReader& reader,
+                     std::vector<NetEntity<N>>& entities) {
+  entities.clear();
+  for (const auto& baseline_entity : baseline) {
+    if (reader.read_bool()) {
+      entities.push_back(
+          {baseline_entity.id,
+           read_field_deltas(baseline_entity.fields, field_bits, reader)});
+    }
+  }
+
+  uint32_t num_new = reader.read_varint();
+  uint32_t id = baseline.empty() ? 0 : baseline.back().id;
+  for (uint32_t i = 0; i < num_new; ++i) {
+    // A truncated datagram could otherwise claim billions of entities
+    if (reader.has_overflowed()) {
+      return false;
+    }
+
+    id += reader.read_varint();
+    auto& entity = entities.emplace_back();
+    entity.id = id;
+    for (size_t field = 0; field < N; ++field) {
+      entity.fields[field] = reader.read(field_bits[field]);
+    }
+  }
+
+  return !reader.has_overflowed();
+}
+
+}  // namespace
+
+void capture_net_state(const World& world, uint32_t tick, NetState& state) {
+  state.tick = tick;
+
+  const auto& player = world.get_player();
+  const auto& weapon = player.get_current_weapon();
+  state.player.fields = {
+      quantize_position(player.get_position().x),
+      quantize_position(player.get_position().y),
+      quantize(player.get_health() * 10.f, NET_PLAYER_BITS[2]),
+      quantize(player.get_stamina(), NET_PLAYER_BITS[3]),
+      static_cast<uint32_t>(std::to_underlying(weapon.type)),
+      quantize(static_cast<float>(weapon.ammo), NET_PLAYER_BITS[5]),
+      player.get_xp()};
+
+  state.zombies.clear();
+  for (const auto& zombie : world.get_zombies()) {
+    state.zombies.push_back(
+        {zombie.get_id(),
+         {quantize_position(zombie.get_position().x),
+          quantize_position(zombie.get_position().y),
+          quantize(zombie.get_health(), NET_ZOMBIE_BITS[2]),
+          quantize(zombie.get_max_health(), NET_ZOMBIE_BITS[3])}});
+  }
+
+  state.bullets.clear();
+  for (const auto& bullet : world.get_bullets()) {
+    state.bullets.push_back(
+        {bullet.get_id(),
+         {quantize_position(bullet.get_position().x),
+          quantize_position(bullet.get_position().y),
+          static_cast<uint32_t>(std::to_underlying(bullet.get_type()))}});
+  }
+
+  state.weapon_crates.clear();
+  for (const auto& crate : world.get_weapon_crates()) {
+    state.weapon_crates.push_back(
+        {crate.get_id(),
+         {quantize_position(crate.get_position().x),
+          quantize_position(crate.get_position().y),
+          static_cast<uint32_t>(std::to_underlying(crate.get_type()))}});
+  }
+}
+
+uint32_t quantize_position(float coordinate) {
+  return quantize(coordinate * POSITION_SCALE, POSITION_BITS);
+}
+
+float dequantize_position(uint32_t quantized) {
+  return static_cast<float>(quantized) / POSITION_SCALE;
+}
+
+void write_net_state_delta(const NetState& baseline, const NetState& state,
+                           BitWriter& writer) {
+  write_field_deltas(baseline.player.fields, state.player.fields,
+                     NET_PLAYER_BITS, writer);
+  write_list_delta<NetZombie::NUM_FIELDS>(baseline.zombies, state.zombies,
+                                          NET_ZOMBIE_BITS, writer);
+  write_list_delta<NetBullet::NUM_FIELDS>(baseline.bullets, state.bullets,
+                                          NET_BULLET_BITS, writer);
+  write_list_delta<NetWeaponCrate::NUM_FIELDS>(
+      baseline.weapon_crates, state.weapon_crates, NET_WEAPON_CRATE_BITS,
+      writer);
+}
+
+bool read_net_state_delta(const NetState& baseline, BitReader& reader,
+                          NetState& state) {
+  state.player.fields =
+      read_field_deltas(baseline.player.fields, NET_PLAYER_BITS, reader);
+  return read_list_delta<NetZombie::NUM_FIELDS>(
+             baseline.zombies, NET_ZOMBIE_BITS, reader, state.zombies) &&
+         read_list_delta<NetBullet::NUM_FIELDS>(
+             baseline.bullets, NET_BULLET_BITS, reader, state.bullets) &&
+         read_list_delta<NetWeaponCrate::NUM_FIELDS>(
+             baseline.weapon_crates, NET_WEAPON_CRATE_BITS, reader,
+             state.weapon_crates);
+}
@@ -0,0 +1,121 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "bit_stream.hpp"
+#include "world.hpp"
+
+/// Quantized positions are in units of 1 / POSITION_SCALE pixels.
+constexpr float POSITION_SCALE = 4.f;
+
+/// Bits per quantized map coordinate.
+constexpr int POSITION_BITS = 14;
+
+/// Entity in a network snapshot, with its fields quantized to integers.
+///
+/// @tparam N Number of fields.
+template <size_t N>
+struct NetEntity {
+  /// Number of fields.
+  static constexpr size_t NUM_FIELDS = N;
+
+  /// Entity ID.
+  uint32_t id = 0;
+
+  /// Quantized fields. Their meaning and bit widths depend on the entity
+  /// type.
+  std::array<uint32_t, N> fields{};
+
+  bool operator==(const NetEntity&) const = default;
+};
+
+/// Player fields: x, y, health in tenths, stamina, current weapon, current
+/// weapon's ammo, XP.
+using NetPlayer = NetEntity<7>;
+
+/// Zombie fields: x, y, health, maximum health.
+using NetZombie = NetEntity<4>;
+
+/// Bullet fields: x, y, weapon type.
+using NetBullet = NetEntity<3>;
+
+/// Weapon crate fields: x, y, weapon type.
+using NetWeaponCrate = NetEntity<3>;
+
+/// Bit widths of the player's fields.
+constexpr std::array<int, NetPlayer::NUM_FIELDS> NET_PLAYER_BITS{
+    POSITION_BITS, POSITION_BITS, 11, 7, 3, 24, 32};
+
+/// Bit widths of a zombie's fields.
+constexpr std::array<int, NetZombie::NUM_FIELDS> NET_ZOMBIE_BITS{
+    POSITION_BITS, POSITION_BITS, 10, 10};
+
+/// Bit widths of a bullet's fields.
+constexpr std::array<int, NetBullet::NUM_FIELDS> NET_BULLET_BITS{
+    POSITION_BITS, POSITION_BITS, 3};
+
+/// Bit widths of a weapon crate's fields.
+constexpr std::array<int, NetWeaponCrate::NUM_FIELDS> NET_WEAPON_CRATE_BITS{
+    POSITION_BITS, POSITION_BITS, 3};
+
+/// Quantized world state sent to network clients.
+///
+/// Entity lists are sorted by ID, and entities that appear after a state was
+/// captured have higher IDs than any entity in it. Delta compression relies on
+/// both.
+struct NetState {
+  /// Server tick the state was captured on.
+  uint32_t tick = 0;
+
+  NetPlayer player;
+  std::vector<NetZombie> zombies;
+  std::vector<NetBullet> bullets;
+  std::vector<NetWeaponCrate> weapon_crates;
+
+  bool operator==(const NetState&) const = default;
+};
+
+/// Quantizes a world's state.
+///
+/// @param world The world.
+/// @param tick Server tick.
+/// @param state The quantized state. Its lists keep their capacity.
+void capture_net_state(const World& world, uint32_t tick, NetState& state);
+
+/// Returns a quantized map coordinate.
+///
+/// @param coordinate Coordinate in pixels.
+uint32_t quantize_position(float coordinate);
+
+/// Returns a map coordinate in pixels from its quantized form.
+///
+/// @param quantized Quantized coordinate.
+float dequantize_position(uint32_t quantized);
+
+/// Writes a state as a delta against a baseline state.
+///
+/// Entities in both states cost one bit if unchanged, and changed fields are
+/// sent as differences, which are usually small. Entities missing from the
+/// state cost one bit, and new ones are sent whole. Pass an empty state as
+/// the baseline to send everything.
+///
+/// @param baseline State the receiver already has.
+/// @param state State to send.
+/// @param writer Writer the delta is appended to.
+void write_net_state_delta(const NetState& baseline, const NetState& state,
+                           BitWriter& writer);
+
+/// Reads a state written by write_net_state_delta().
+///
+/// @param baseline The baseline state the delta was written against.
+/// @param reader Reader positioned at the delta.
+/// @param state The state. Its tick is left as is.
+/// @return False if the delta was malformed.
+bool read_net_state_delta(const NetState& baseline, BitReader& reader,
+                          NetState& state);
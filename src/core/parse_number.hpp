@@ -0,0 +1,18 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <charconv>
+#include <string_view>
+#include <system_error>
+
+/// Parses a number from a command-line argument.
+///
+/// @param arg The argument.
+/// @param value The parsed value.
+/// @return True on success.
+template <typename T>
+bool parse_number(std::string_view arg, T& value) {
+  auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+  return ec == std::errc{} && ptr == arg.data() + arg.size();
+}
@@ -0,0 +1,59 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+/// Frame phases timed by the profiler.
+enum class Phase : uint8_t {
+  INPUT,
+  FIRING,
+  BULLET_MOVEMENT,
+  PLAYER_MOVEMENT,
+  ZOMBIE_MOVEMENT,
+  TIMERS,
+  SPAWNING,
+  BULLET_ZOMBIE_COLLISION,
+  WEAPON_CRATE_COLLISION,
+  CONTACT_DAMAGE,
+  DRAW_GROUND,
+  DRAW_WEAPON_CRATES,
+  DRAW_ZOMBIES,
+  DRAW_PLAYER,
+  DRAW_BULLETS,
+  DRAW_OVERLAY,
+  CAPTURE,
+  PACE,
+  DISPLAY
+};
+
+constexpr int NUM_PHASES = 19;
+
+/// Returns a human-readable name for the given phase.
+constexpr std::string_view phase_name(Phase phase) {
+  constexpr std::array<std::string_view, NUM_PHASES> NAMES{
+      "input",
+      "firing",
+      "bullet movement",
+      "player movement",
+      "zombie movement",
+      "timers",
+      "spawning",
+      "bullet-zombie collision",
+      "weapon crate collision",
+      "contact damage",
+      "draw ground",
+      "draw weapon crates",
+      "draw zombies",
+      "draw player",
+      "draw bullets",
+      "draw overlay",
+      "capture",
+      "pace",
+      "display"};
+  return NAMES[std::to_underlying(phase)];
+}
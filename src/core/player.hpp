@@ -7,15 +7,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <numbers>
 #include <utility>
 
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/ConvexShape.hpp>
 #include <SFML/Graphics/Rect.hpp>
-#include <SFML/Graphics/RenderWindow.hpp>
-#include <SFML/Graphics/Shader.hpp>
-#include <SFML/System/Clock.hpp>
+#include <SFML/System/Angle.hpp>
 #include <SFML/System/Vector2.hpp>
 
 #include "constants.hpp"
@@ -25,26 +20,13 @@
 /// Player entity.
 class Player {
  public:
+  /// Maximum health of every player. It never changes.
+  static constexpr float MAX_HEALTH = 100.f;
+
   /// Constructs a Player.
   ///
   /// @param position Initial position.
-  explicit Player(const sf::Vector2f& position) {
-    this->position = position;
-
-    stamina_arc.setPosition(position);
-    stamina_arc.setFillColor(sf::Color::Blue);
-
-    body_shape.setPosition(position);
-    body_shape.setRadius(max_health / 10.f);
-    body_shape.setOrigin(body_shape.getGeometricCenter());
-
-    body_shader_state.shader = &body_shader;
-
-    center_shape.setPosition(position);
-    center_shape.setFillColor(sf::Color::Black);
-    center_shape.setRadius((max_health - health) / 10.f);
-    center_shape.setOrigin(center_shape.getGeometricCenter());
-  }
+  explicit Player(const sf::Vector2f& position) : position{position} {}
 
   Player(Player&&) = default;
   Player& operator=(Player&&) = default;
@@ -67,11 +49,23 @@ class Player {
   /// Returns the player's health.
   float get_health() const { return health; }
 
+  /// Returns the player's maximum health.
+  float get_max_health() const { return max_health; }
+
   /// Decrements the player's health by the given amount.
   ///
   /// @param decrement The amount to decrement.
   void decrement_health(float decrement) { health -= decrement; }
 
+  /// Returns the player's stamina.
+  float get_stamina() const { return stamina; }
+
+  /// Returns the player's maximum stamina.
+  float get_max_stamina() const { return max_stamina; }
+
+  /// Returns whether the player has enough stamina to sprint.
+  bool sprint_available() const { return can_sprint; }
+
   /// Returns the player's accrued experience.
   uint32_t get_xp() const { return xp; }
 
@@ -81,7 +75,14 @@ class Player {
   void increment_xp(uint32_t increment) { xp += increment; }
 
   /// Returns the player's radius for collision detection.
-  float get_radius() const { return max_health / 10.f; }
+  float get_radius() const { return get_radius(max_health); }
+
+  /// Returns the radius of a player with the given maximum health.
+  ///
+  /// @param max_health The player's maximum health.
+  static constexpr float get_radius(float max_health) {
+    return max_health / 10.f;
+  }
 
   /// Returns the global bounds for collision detection.
   sf::FloatRect get_global_bounds() const {
@@ -116,9 +117,6 @@ class Player {
 
     if (PLAYER_BOUNDS.contains(position + delta_position)) {
       position += delta_position;
-      stamina_arc.move(delta_position);
-      body_shape.move(delta_position);
-      center_shape.move(delta_position);
     }
 
     if (stamina <= 0.f) {
@@ -128,45 +126,14 @@ class Player {
       can_sprint = true;
     }
     stamina = std::min(stamina + 10.f * frame_duration, 100.f);
-  }
-
-  /// Draws player on main window.
-  ///
-  /// @param main_window Main window.
-  void draw(sf::RenderWindow& main_window) {
-    for (size_t i = 0; i < 30; ++i) {
-      auto angle = sf::radians(i / 29.f * 2.0 * std::numbers::pi_v<float> *
-                               stamina / max_stamina);
-      angle -= sf::radians(std::numbers::pi_v<float> / 2.f);
-      stamina_arc.setPoint(i, {get_radius() + 5.f, angle});
-    }
-    stamina_arc.setPoint(30, {0.f, 0.f});
-
-    if (can_sprint) {
-      stamina_arc.setFillColor(sf::Color::Blue);
-    } else {
-      stamina_arc.setFillColor(CANT_SPRINT_COLOR);
-    }
-
-    body_shape.setRadius(max_health / 10.f);
-    body_shape.setOrigin(body_shape.getGeometricCenter());
 
-    center_shape.setRadius((max_health - health) / 10.f);
-    center_shape.setOrigin(center_shape.getGeometricCenter());
-
-    get_current_weapon().draw(main_window, position);
-
-    // Update shader inputs
-    body_shader.setUniform("texture", sf::Shader::CurrentTexture);
-    body_shader.setUniform("center",
-                           position - main_window.getView().getCenter() +
-                               sf::Vector2f{main_window.getSize()} / 2.f);
-
-    main_window.draw(stamina_arc);
-    main_window.draw(body_shape, body_shader_state);
-    main_window.draw(center_shape);
+    time_since_fire += frame_duration;
   }
 
+  /// Returns the currently equipped weapon.
+  const Weapon& get_current_weapon() const { return weapons[current_weapon]; }
+
+  /// Returns the currently equipped weapon.
   Weapon& get_current_weapon() { return weapons[current_weapon]; }
 
   /// Returns the weapon with the given type.
@@ -176,6 +143,13 @@ class Player {
     return weapons[std::to_underlying(type)];
   }
 
+  /// Returns the weapon with the given type.
+  ///
+  /// @param type The weapon type.
+  const Weapon& get_weapon(WeaponType type) const {
+    return weapons[std::to_underlying(type)];
+  }
+
   /// Switch to previous weapon.
   void switch_to_previous_weapon() {
     if (current_weapon == 0) {
@@ -200,10 +174,12 @@ class Player {
   }
 
   /// Returns true and resets timer if player can fire another bullet.
-  bool try_fire() {
-    if (fire_period_clock.getElapsedTime().asSeconds() >
-        get_current_weapon().fire_period) {
-      fire_period_clock.restart();
+  ///
+  /// @param delay Seconds into the frame at which the player fires.
+  bool try_fire(float delay = 0.f) {
+    if (time_since_fire + delay > get_current_weapon().fire_period) {
+      // The timer advances by the whole frame later in the step
+      time_since_fire = -delay;
       return true;
     } else {
       return false;
@@ -211,20 +187,19 @@ class Player {
   }
 
  private:
-  static constexpr sf::Color CANT_SPRINT_COLOR{128, 128, 255};
-
   sf::Vector2f position;
   sf::Vector2f velocity;
 
   float speed = 50.f;
 
-  sf::Clock fire_period_clock;
+  /// Simulation time in seconds since the player last fired.
+  float time_since_fire = 0.f;
 
   /// Player's current health.
   float health = 100.f;
 
   /// Player's maximum health.
-  float max_health = 100.f;
+  float max_health = MAX_HEALTH;
 
   /// Player's stamina.
   float stamina = 100.f;
@@ -244,34 +219,4 @@ class Player {
       Weapon{WeaponType::SHOTGUN, 0},        Weapon{WeaponType::MINIGUN, 0},
       Weapon{WeaponType::ROCKET_LAUNCHER, 0}};
   int current_weapon = 0;
-
-  sf::ConvexShape stamina_arc{31};
-
-  sf::CircleShape body_shape;
-  sf::Shader body_shader{std::string_view{R"(
-#version 330
-
-uniform sampler2D texture;
-uniform vec2 center;
-
-// Based on https://en.wikipedia.org/wiki/HSL_and_HSV#HSV_to_RGB_alternative
-float f(float h, float s, float v, float n) {
-  float k = mod(n + h / 60.f, 6.f);
-  return v - s * v * clamp(min(k, 4.f - k), 0.f, 1.f);
-}
-
-vec4 hsv_to_rgb(float h, float s, float v, float a) {
-  return vec4(f(h, s, v, 5), f(h, s, v, 3), f(h, s, v, 1), a);
-}
-
-void main() {
-  float angle = atan(gl_FragCoord.y - center.y, gl_FragCoord.x - center.x);  // NOLINT
-  float alpha = texture2D(texture, gl_FragCoord.xy).a;
-
-  gl_FragColor = hsv_to_rgb(degrees(angle) + 180.f, 1.f, 1.f, alpha);
-})"},
-                         sf::Shader::Type::Fragment};
-  sf::RenderStates body_shader_state;
-
-  sf::CircleShape center_shape;
 };
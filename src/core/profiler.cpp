@@ -0,0 +1,24 @@
+// Copyright (c) Tyler Veness
+
+#include "profiler.hpp"
+
+#include <chrono>
+
+void Profiler::begin_frame(float frame_duration) {
+  for (int i = 0; i < NUM_PHASES; ++i) {
+    last_phase_times[i] =
+        std::chrono::duration<double, std::milli>{current_phase_times[i]}
+            .count();
+    average_phase_times[i] += AVERAGE_WEIGHT *
+                              (last_phase_times[i] - average_phase_times[i]);
+    current_phase_times[i] = std::chrono::nanoseconds{0};
+  }
+
+  frame_durations[next_frame_index] = frame_duration;
+  next_frame_index = (next_frame_index + 1) % HISTORY_SIZE;
+}
+
+Profiler& global_profiler() {
+  static Profiler profiler;
+  return profiler;
+}
@@ -0,0 +1,112 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <utility>
+
+#include "allocation_tracker.hpp"
+#include "phase.hpp"
+#include "trace.hpp"
+
+/// Collects per-phase timings and a rolling frame time history.
+class Profiler {
+ public:
+  /// Number of frames kept in the frame time history.
+  static constexpr size_t HISTORY_SIZE = 240;
+
+  /// Finishes the current frame and starts a new one.
+  ///
+  /// @param frame_duration Duration of the finished frame in seconds.
+  void begin_frame(float frame_duration);
+
+  /// Adds time spent in the given phase during the current frame.
+  ///
+  /// @param phase The phase.
+  /// @param duration Time spent.
+  void add_phase_time(Phase phase, std::chrono::nanoseconds duration) {
+    current_phase_times[std::to_underlying(phase)] += duration;
+  }
+
+  /// Returns the time spent in the given phase during the last finished frame
+  /// in milliseconds.
+  ///
+  /// @param phase The phase.
+  double get_phase_time(Phase phase) const {
+    return last_phase_times[std::to_underlying(phase)];
+  }
+
+  /// Returns the exponential moving average of the time spent in the given
+  /// phase per frame in milliseconds.
+  ///
+  /// @param phase The phase.
+  double get_average_phase_time(Phase phase) const {
+    return average_phase_times[std::to_underlying(phase)];
+  }
+
+  /// Returns the frame duration history in seconds as a ring buffer.
+  const std::array<float, HISTORY_SIZE>& get_frame_durations() const {
+    return frame_durations;
+  }
+
+  /// Returns the index in the frame duration history of the oldest frame.
+  size_t get_oldest_frame_index() const { return next_frame_index; }
+
+ private:
+  /// Weight of the newest frame in the moving averages.
+  static constexpr double AVERAGE_WEIGHT = 0.05;
+
+  std::array<std::chrono::nanoseconds, NUM_PHASES> current_phase_times{};
+  std::array<double, NUM_PHASES> last_phase_times{};
+  std::array<double, NUM_PHASES> average_phase_times{};
+
+  std::array<float, HISTORY_SIZE> frame_durations{};
+  size_t next_frame_index = 0;
+};
+
+/// Returns the application-wide profiler.
+Profiler& global_profiler();
+
+/// Adds the time from construction to destruction to a phase of the
+/// application-wide profiler and, if tracing is enabled, records it as a trace
+/// event. Heap allocations made meanwhile are attributed to the phase.
+class ScopedPhaseTimer {
+ public:
+  /// Starts timing the given phase.
+  ///
+  /// @param phase The phase.
+  explicit ScopedPhaseTimer(Phase phase)
+      : phase{phase}, start_time{std::chrono::steady_clock::now()} {
+#ifdef ENABLE_ALLOCATION_TRACKING
+    previous_allocation_phase =
+        AllocationTracker::set_current_phase(std::to_underlying(phase));
+#endif
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+  ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+  ~ScopedPhaseTimer() {
+    auto end_time = std::chrono::steady_clock::now();
+    global_profiler().add_phase_time(phase, end_time - start_time);
+#ifdef ENABLE_TRACING
+    if (global_tracer().is_recording()) {
+      global_tracer().add_event(phase_name(phase), start_time, end_time);
+    }
+#endif
+#ifdef ENABLE_ALLOCATION_TRACKING
+    AllocationTracker::set_current_phase(previous_allocation_phase);
+#endif
+  }
+
+ private:
+  Phase phase;
+  std::chrono::steady_clock::time_point start_time;
+#ifdef ENABLE_ALLOCATION_TRACKING
+  int previous_allocation_phase;
+#endif
+};
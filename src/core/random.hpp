@@ -0,0 +1,124 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <bit>
+#include <limits>
+#include <span>
+
+/// xoshiro128** pseudorandom number generator.
+///
+/// It's much smaller and faster than std::mt19937, and it satisfies
+/// UniformRandomBitGenerator, so it also works with the standard
+/// distributions. Generators built from the same seed with different stream
+/// IDs are statistically independent, so each system or thread can own one
+/// without sharing state.
+class Random {
+ public:
+  using result_type = uint32_t;
+
+  /// Constructs a generator.
+  ///
+  /// @param seed Seed shared by related streams.
+  /// @param stream Stream ID that distinguishes generators with the same seed.
+  explicit Random(uint64_t seed = 0, uint64_t stream = 0) {
+    // Expand the seed with splitmix64 so similar seeds and stream IDs give
+    // unrelated states. splitmix64 never outputs zero twice in a row, so the
+    // state can't be all zeros.
+    uint64_t splitmix_state = seed ^ (stream * 0xd1b5'4a32'd192'ed03);
+    for (size_t i = 0; i < state.size(); i += 2) {
+      uint64_t value = splitmix64(splitmix_state);
+      state[i] = static_cast<uint32_t>(value);
+      state[i + 1] = static_cast<uint32_t>(value >> 32);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /// Returns 32 uniformly distributed random bits.
+  result_type operator()() {
+    uint32_t result = std::rotl(state[1] * 5, 7) * 9;
+    uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = std::rotl(state[3], 11);
+
+    return result;
+  }
+
+  /// Returns a uniformly distributed float in [0, 1).
+  float uniform() { return to_unit_float((*this)()); }
+
+  /// Returns a uniformly distributed float in [min, max).
+  ///
+  /// @param min Lower bound.
+  /// @param max Upper bound.
+  float uniform(float min, float max) {
+    return min + (max - min) * uniform();
+  }
+
+  /// Returns a uniformly distributed integer in [0, bound).
+  ///
+  /// Uses a multiply and shift instead of division. The bias is at most
+  /// bound / 2³², which is negligible for the small bounds used in game logic.
+  ///
+  /// @param bound Exclusive upper bound.
+  uint32_t uniform_int(uint32_t bound) {
+    return static_cast<uint32_t>((static_cast<uint64_t>((*this)()) * bound) >>
+                                 32);
+  }
+
+  /// Fills a span with uniformly distributed random bits.
+  ///
+  /// @param values The values to fill.
+  void fill(std::span<uint32_t> values) {
+    for (auto& value : values) {
+      value = (*this)();
+    }
+  }
+
+  /// Fills a span with uniformly distributed floats in [min, max).
+  ///
+  /// @param values The values to fill.
+  /// @param min Lower bound.
+  /// @param max Upper bound.
+  void fill_uniform(std::span<float> values, float min, float max) {
+    float range = max - min;
+    for (auto& value : values) {
+      value = min + range * to_unit_float((*this)());
+    }
+  }
+
+ private:
+  std::array<uint32_t, 4> state;
+
+  /// Returns a float in [0, 1) built from the high 24 bits, which is all a
+  /// float's significand holds.
+  ///
+  /// @param bits Uniformly distributed random bits.
+  static float to_unit_float(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * 0x1p-24f;
+  }
+
+  /// Advances a splitmix64 state and returns its next output.
+  ///
+  /// @param state The splitmix64 state.
+  static uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e37'79b9'7f4a'7c15);
+    z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+    z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+    return z ^ (z >> 31);
+  }
+};
@@ -0,0 +1,39 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <numbers>
+#include <span>
+
+#include <SFML/System/Angle.hpp>
+
+#include "random.hpp"
+
+/// Returns the maximum angle error in radians for the given accuracy.
+///
+/// @param accuracy Percent accuracy in the range [0, 1].
+constexpr float max_angle_error(float accuracy) {
+  return (1.f - accuracy) * std::numbers::pi_v<float>;
+}
+
+/// Returns random angle within the given tolerance.
+///
+/// @param random Random number generator.
+/// @param accuracy Percent accuracy in the range [0, 1]. A 0 maps to [−π, π]
+///     and a 1 maps to [0, 0].
+inline sf::Angle random_angle(Random& random, float accuracy) {
+  float angle_error = max_angle_error(accuracy);
+  return sf::radians(random.uniform(-angle_error, angle_error));
+}
+
+/// Fills a span with random angles in radians within the given tolerance.
+///
+/// @param random Random number generator.
+/// @param angles The angles to fill.
+/// @param accuracy Percent accuracy in the range [0, 1]. A 0 maps to [−π, π]
+///     and a 1 maps to [0, 0].
+inline void fill_random_angles(Random& random, std::span<float> angles,
+                               float accuracy) {
+  float angle_error = max_angle_error(accuracy);
+  random.fill_uniform(angles, -angle_error, angle_error);
+}
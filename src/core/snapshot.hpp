@@ -0,0 +1,124 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/// Compact binary copy of simulation state.
+///
+/// Values are stored as their raw bytes and read back in the order they were
+/// written, so only trivially copyable types can be stored. The buffer keeps
+/// its capacity across clear(), so a reused snapshot stops allocating once
+/// it's grown to fit the state.
+class Snapshot {
+ public:
+  /// Discards the contents but keeps the buffer.
+  void clear() { bytes.clear(); }
+
+  /// Returns the size in bytes.
+  size_t get_size() const { return bytes.size(); }
+
+  /// Appends a value.
+  ///
+  /// @param value The value.
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void write(const T& value) {
+    write_bytes(&value, sizeof(T));
+  }
+
+  /// Appends a list's size, then its elements.
+  ///
+  /// @param values The list.
+  template <std::ranges::sized_range R>
+    requires std::is_trivially_copyable_v<std::ranges::range_value_t<R>>
+  void write_list(const R& values) {
+    write(std::ranges::size(values));
+    if constexpr (std::ranges::contiguous_range<R>) {
+      write_bytes(std::ranges::data(values),
+                  std::ranges::size(values) *
+                      sizeof(std::ranges::range_value_t<R>));
+    } else {
+      for (const auto& value : values) {
+        write(value);
+      }
+    }
+  }
+
+ private:
+  friend class SnapshotReader;
+
+  std::vector<std::byte> bytes;
+
+  /// Appends raw bytes.
+  ///
+  /// @param data The bytes.
+  /// @param size Number of bytes.
+  void write_bytes(const void* data, size_t size) {
+    auto begin = static_cast<const std::byte*>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+  }
+};
+
+/// Reads values back from a Snapshot in the order they were written.
+class SnapshotReader {
+ public:
+  /// Constructs a SnapshotReader positioned at the start of a snapshot.
+  ///
+  /// @param snapshot The snapshot. It must outlive the reader.
+  explicit SnapshotReader(const Snapshot& snapshot) : bytes{snapshot.bytes} {}
+
+  /// Reads the next value.
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  T read() {
+    // Copied out since the bytes aren't aligned for T
+    std::array<std::byte, sizeof(T)> raw;
+    memcpy(raw.data(), bytes.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return std::bit_cast<T>(raw);
+  }
+
+  /// Replaces a list's contents with the next list, which was written by
+  /// Snapshot::write_list().
+  ///
+  /// @param values The list.
+  template <typename C>
+  void read_list(C& values) {
+    using T = typename C::value_type;
+
+    auto size = read<size_t>();
+    if constexpr (std::ranges::contiguous_range<C>) {
+      // Elements are trivially copyable, so existing ones are overwritten in
+      // one copy. Only the elements past the current size are constructed.
+      size_t num_overwritten = std::min(values.size(), size);
+      values.erase(values.begin() + num_overwritten, values.end());
+      if (num_overwritten > 0) {
+        memcpy(values.data(), bytes.data() + offset,
+               num_overwritten * sizeof(T));
+        offset += num_overwritten * sizeof(T);
+      }
+      for (size_t i = num_overwritten; i < size; ++i) {
+        values.push_back(read<T>());
+      }
+    } else {
+      values.clear();
+      for (size_t i = 0; i < size; ++i) {
+        values.push_back(read<T>());
+      }
+    }
+  }
+
+ private:
+  std::span<const std::byte> bytes;
+  size_t offset = 0;
+};
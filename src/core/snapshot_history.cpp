@@ -0,0 +1,28 @@
+// Copyright (c) Tyler Veness
+
+#include "snapshot_history.hpp"
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "world.hpp"
+
+void SnapshotHistory::record(const World& world) {
+  world.save(snapshots[next_index]);
+  next_index = (next_index + 1) % snapshots.size();
+  size = std::min(size + 1, snapshots.size());
+}
+
+bool SnapshotHistory::rewind(World& world, size_t ticks) {
+  if (ticks >= size) {
+    return false;
+  }
+
+  // The restored snapshot becomes the newest
+  next_index = (next_index + snapshots.size() - ticks) % snapshots.size();
+  size -= ticks;
+  world.restore(
+      snapshots[(next_index + snapshots.size() - 1) % snapshots.size()]);
+  return true;
+}
@@ -0,0 +1,54 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "snapshot.hpp"
+#include "world.hpp"
+
+/// Ring buffer of the most recent world snapshots, for rewinding.
+///
+/// Snapshot buffers are reused once the ring wraps, so recording stops
+/// allocating once every slot has grown to fit the state.
+class SnapshotHistory {
+ public:
+  /// Constructs an empty SnapshotHistory.
+  ///
+  /// @param capacity Number of snapshots kept.
+  explicit SnapshotHistory(size_t capacity) : snapshots(capacity) {}
+
+  /// Records the world's state as the newest snapshot, replacing the oldest
+  /// if the history is full.
+  ///
+  /// @param world The world.
+  void record(const World& world);
+
+  /// Restores the world to a recorded state and discards the snapshots
+  /// recorded after it.
+  ///
+  /// @param world The world.
+  /// @param ticks How many snapshots before the newest to restore.
+  /// @return False if fewer snapshots are recorded, in which case the world is
+  ///   left as is.
+  bool rewind(World& world, size_t ticks);
+
+  /// Discards every snapshot.
+  void clear() { size = 0; }
+
+  /// Returns the number of snapshots recorded.
+  size_t get_size() const { return size; }
+
+  /// Returns the number of snapshots kept.
+  size_t get_capacity() const { return snapshots.size(); }
+
+ private:
+  std::vector<Snapshot> snapshots;
+
+  /// Index of the slot the next snapshot goes in.
+  size_t next_index = 0;
+
+  size_t size = 0;
+};
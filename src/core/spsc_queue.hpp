@@ -0,0 +1,65 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
+
+/// Bounded lock-free queue for one producer thread and one consumer thread.
+///
+/// Neither side ever blocks or allocates. The indices live on separate cache
+/// lines so the two threads don't contend on them.
+///
+/// @tparam T Element type.
+/// @tparam N Capacity. A power of two keeps the index math cheap.
+template <typename T, size_t N>
+class SpscQueue {
+ public:
+  /// Appends an element. Only the producer thread may call this.
+  ///
+  /// @param value The element.
+  /// @return False if the queue was full and the element was dropped.
+  bool push(const T& value) {
+    size_t tail = this->tail.load(std::memory_order_relaxed);
+    if (tail - head.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+
+    elements[tail % N] = value;
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Returns the oldest element, or nullptr if the queue is empty. Only the
+  /// consumer thread may call this, and the element stays valid until it's
+  /// popped.
+  const T* front() const {
+    size_t head = this->head.load(std::memory_order_relaxed);
+    if (head == tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &elements[head % N];
+  }
+
+  /// Removes the oldest element. Only the consumer thread may call this, and
+  /// only when front() returned an element.
+  void pop() {
+    head.store(head.load(std::memory_order_relaxed) + 1,
+               std::memory_order_release);
+  }
+
+ private:
+  /// Typical cache line size. std::hardware_destructive_interference_size
+  /// isn't used since GCC warns it may differ between compiler flags.
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  std::array<T, N> elements{};
+
+  /// Count of elements popped. Written by the consumer.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> head = 0;
+
+  /// Count of elements pushed. Written by the producer.
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail = 0;
+};
@@ -0,0 +1,108 @@
+// Copyright (c) Tyler Veness
+
+#include "thread_pool.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "trace.hpp"
+
+ThreadPool::ThreadPool(int num_threads) {
+  for (int i = 1; i < num_threads; ++i) {
+    workers.emplace_back([this] { worker_main(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock{mutex};
+    stopping = true;
+  }
+  work_cv.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::run(size_t count, size_t chunk_size, void* context,
+                     ChunkFunction chunk_function) {
+  chunk_size = std::max<size_t>(chunk_size, 1);
+
+  // Not worth waking the workers for a single chunk
+  if (workers.empty() || count <= chunk_size) {
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+      chunk_function(context, begin, std::min(begin + chunk_size, count));
+    }
+    return;
+  }
+
+  {
+    std::scoped_lock lock{mutex};
+    this->context = context;
+    this->chunk_function = chunk_function;
+    this->count = count;
+    this->chunk_size = chunk_size;
+    next_index.store(0, std::memory_order_relaxed);
+    busy_workers = static_cast<int>(workers.size());
+    ++generation;
+  }
+  work_cv.notify_all();
+
+  run_chunks();
+
+  // Every worker checks in before returning so none can still be reading this
+  // loop's state when the next one starts
+  std::unique_lock lock{mutex};
+  done_cv.wait(lock, [&] { return busy_workers == 0; });
+}
+
+void ThreadPool::run_chunks() {
+  TRACE_SCOPE("thread pool chunks");
+
+  while (true) {
+    size_t begin = next_index.fetch_add(chunk_size, std::memory_order_relaxed);
+    if (begin >= count) {
+      return;
+    }
+    chunk_function(context, begin, std::min(begin + chunk_size, count));
+  }
+}
+
+void ThreadPool::worker_main() {
+  uint64_t last_generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock{mutex};
+      work_cv.wait(lock,
+                   [&] { return stopping || generation != last_generation; });
+      if (stopping) {
+        return;
+      }
+      last_generation = generation;
+    }
+
+    run_chunks();
+
+    bool last_worker;
+    {
+      std::scoped_lock lock{mutex};
+      last_worker = --busy_workers == 0;
+    }
+    if (last_worker) {
+      done_cv.notify_one();
+    }
+  }
+}
+
+ThreadPool& global_thread_pool() {
+  static ThreadPool thread_pool{
+      static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u))};
+  return thread_pool;
+}
@@ -0,0 +1,87 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// Fixed-size pool of worker threads that split loops into chunks.
+class ThreadPool {
+ public:
+  /// Constructs a ThreadPool.
+  ///
+  /// @param num_threads Number of threads running each loop, including the
+  ///   calling thread. One runs loops serially on the calling thread.
+  explicit ThreadPool(int num_threads);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool();
+
+  /// Returns the number of threads running each loop, including the calling
+  /// thread.
+  int get_thread_count() const { return static_cast<int>(workers.size()) + 1; }
+
+  /// Calls func(begin, end) for consecutive chunks of [0, count) and blocks
+  /// until all chunks are done. Chunks are handed out to whichever thread is
+  /// free next, so func must not depend on which thread runs a chunk or in
+  /// what order.
+  ///
+  /// @param count Number of elements.
+  /// @param chunk_size Number of elements per chunk.
+  /// @param func Callable taking the begin and end indices of a chunk.
+  template <typename F>
+  void parallel_for(size_t count, size_t chunk_size, F&& func) {
+    run(count, chunk_size, &func,
+        [](void* context, size_t begin, size_t end) {
+          (*static_cast<std::remove_reference_t<F>*>(context))(begin, end);
+        });
+  }
+
+ private:
+  using ChunkFunction = void (*)(void* context, size_t begin, size_t end);
+
+  std::vector<std::thread> workers;
+
+  std::mutex mutex;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+
+  // Current loop, guarded by mutex
+  void* context = nullptr;
+  ChunkFunction chunk_function = nullptr;
+  size_t count = 0;
+  size_t chunk_size = 1;
+  uint64_t generation = 0;
+  int busy_workers = 0;
+  bool stopping = false;
+
+  std::atomic<size_t> next_index = 0;
+
+  /// Runs a loop on the pool.
+  ///
+  /// @param count Number of elements.
+  /// @param chunk_size Number of elements per chunk.
+  /// @param context Callable passed to chunk_function.
+  /// @param chunk_function Function that runs one chunk.
+  void run(size_t count, size_t chunk_size, void* context,
+           ChunkFunction chunk_function);
+
+  /// Runs chunks of the current loop until none are left.
+  void run_chunks();
+
+  /// Worker thread body.
+  void worker_main();
+};
+
+/// Returns the application-wide thread pool, which has one thread per hardware
+/// thread.
+ThreadPool& global_thread_pool();
@@ -0,0 +1,124 @@
+// Copyright (c) Tyler Veness
+
+#include "timer_wheel.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+
+#include "snapshot.hpp"
+
+TimerWheel::TimerWheel() {
+  for (auto& level : slots) {
+    level.fill(NONE);
+  }
+}
+
+void TimerWheel::schedule(float delay, TimerType type, uint32_t id) {
+  uint64_t ticks = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(delay / TICK_DURATION)), 1);
+
+  uint32_t index;
+  if (free_list != NONE) {
+    index = free_list;
+    free_list = nodes[index].next;
+  } else {
+    index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+  }
+  nodes[index] = Node{current_tick + ticks, TimerEvent{type, id}, NONE};
+
+  insert(index);
+}
+
+void TimerWheel::advance(float duration,
+                         std::pmr::vector<TimerEvent>& fired) {
+  remainder += duration / TICK_DURATION;
+  auto ticks = static_cast<uint64_t>(remainder);
+  remainder -= static_cast<float>(ticks);
+
+  for (; ticks > 0; --ticks) {
+    ++current_tick;
+
+    // When a level wraps, the next slot up covers the upcoming ticks, so its
+    // timers move down
+    for (int level = 1; level < NUM_LEVELS; ++level) {
+      if (get_slot(level - 1, current_tick) != 0) {
+        break;
+      }
+      cascade(level, get_slot(level, current_tick));
+    }
+
+    // Every timer left in the bottom slot is due this tick
+    auto& head = slots[0][get_slot(0, current_tick)];
+    while (head != NONE) {
+      uint32_t index = head;
+      head = nodes[index].next;
+
+      fired.emplace_back(nodes[index].event);
+      nodes[index].next = free_list;
+      free_list = index;
+    }
+  }
+}
+
+void TimerWheel::clear() {
+  nodes.clear();
+  free_list = NONE;
+  for (auto& level : slots) {
+    level.fill(NONE);
+  }
+  current_tick = 0;
+  remainder = 0.f;
+}
+
+void TimerWheel::save(Snapshot& snapshot) const {
+  snapshot.write_list(nodes);
+  snapshot.write(free_list);
+  snapshot.write(slots);
+  snapshot.write(current_tick);
+  snapshot.write(remainder);
+}
+
+void TimerWheel::restore(SnapshotReader& reader) {
+  reader.read_list(nodes);
+  free_list = reader.read<uint32_t>();
+  slots = reader.read<decltype(slots)>();
+  current_tick = reader.read<uint64_t>();
+  remainder = reader.read<float>();
+}
+
+void TimerWheel::insert(uint32_t index) {
+  auto& node = nodes[index];
+  uint64_t delta = node.deadline - current_tick;
+
+  // Pick the lowest level whose slots still span the whole delay. A timer
+  // beyond the top level's range waits in its furthest slot and is refiled
+  // from there.
+  int level = 0;
+  while (level < NUM_LEVELS - 1 &&
+         delta >= uint64_t{1} << ((level + 1) * SLOT_BITS)) {
+    ++level;
+  }
+  uint64_t tick = std::min(
+      node.deadline,
+      current_tick + (uint64_t{1} << (NUM_LEVELS * SLOT_BITS)) - 1);
+
+  auto& head = slots[level][get_slot(level, tick)];
+  node.next = head;
+  head = index;
+}
+
+void TimerWheel::cascade(int level, size_t slot) {
+  uint32_t index = slots[level][slot];
+  slots[level][slot] = NONE;
+
+  while (index != NONE) {
+    uint32_t next = nodes[index].next;
+    insert(index);
+    index = next;
+  }
+}
@@ -0,0 +1,129 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+#include "snapshot.hpp"
+
+/// Simulation events fired by timers.
+enum class TimerType : uint8_t {
+  /// A bullet reached its maximum lifetime.
+  BULLET_EXPIRY,
+
+  /// A weapon crate reached its maximum lifetime.
+  WEAPON_CRATE_EXPIRY,
+
+  /// The next weapon crate is due.
+  WEAPON_CRATE_SPAWN
+};
+
+/// Timer that fired.
+struct TimerEvent {
+  /// Timer type.
+  TimerType type;
+
+  /// ID of the entity the timer belongs to, if any.
+  uint32_t id;
+};
+
+/// Hierarchical timer wheel driven by simulation time.
+///
+/// Each level has 64 slots, and each slot on a level spans 64 times as many
+/// ticks as one on the level below. Timers are filed in the slot that covers
+/// their deadline and moved down a level whenever the level below wraps, so
+/// scheduling is O(1) and advancing costs O(1) per tick plus O(1) per timer
+/// that fires or cascades. Nothing polls timers that aren't due.
+///
+/// Timers can't be cancelled. Handlers look up the entity by ID and ignore
+/// timers whose entity is already gone.
+class TimerWheel {
+ public:
+  /// Simulation time per tick in seconds. It's a power of two so whole
+  /// seconds are exact tick counts.
+  static constexpr float TICK_DURATION = 1.f / 1024.f;
+
+  /// Constructs an empty TimerWheel.
+  TimerWheel();
+
+  /// Schedules a timer.
+  ///
+  /// @param delay Simulation time in seconds until the timer fires. It's
+  ///   rounded up to a whole number of ticks, and at least one.
+  /// @param type Timer type.
+  /// @param id ID of the entity the timer belongs to.
+  void schedule(float delay, TimerType type, uint32_t id = 0);
+
+  /// Advances simulation time and appends timers that fired to a list in
+  /// deadline order.
+  ///
+  /// @param duration Simulation time in seconds to advance by. Fractions of
+  ///   a tick carry over to the next call.
+  /// @param fired The list of fired timers.
+  void advance(float duration, std::pmr::vector<TimerEvent>& fired);
+
+  /// Removes all timers and rewinds to time zero.
+  void clear();
+
+  /// Appends the pending timers and current time to a snapshot.
+  ///
+  /// @param snapshot The snapshot.
+  void save(Snapshot& snapshot) const;
+
+  /// Replaces the pending timers and current time with ones read from a
+  /// snapshot.
+  ///
+  /// @param reader Reader positioned where save() wrote.
+  void restore(SnapshotReader& reader);
+
+ private:
+  static constexpr int SLOT_BITS = 6;
+  static constexpr size_t NUM_SLOTS = size_t{1} << SLOT_BITS;
+  static constexpr int NUM_LEVELS = 4;
+
+  /// Marks the end of a slot's list.
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  /// Timer in a slot's singly linked list.
+  struct Node {
+    uint64_t deadline;
+    TimerEvent event;
+    uint32_t next;
+  };
+
+  /// Node storage. Fired nodes go on the free list for reuse.
+  std::vector<Node> nodes;
+  uint32_t free_list = NONE;
+
+  /// Head node of each slot's list.
+  std::array<std::array<uint32_t, NUM_SLOTS>, NUM_LEVELS> slots;
+
+  uint64_t current_tick = 0;
+
+  /// Fraction of a tick not yet advanced.
+  float remainder = 0.f;
+
+  /// Files a node in the slot covering its deadline.
+  ///
+  /// @param index Node index.
+  void insert(uint32_t index);
+
+  /// Refiles a slot's timers on lower levels.
+  ///
+  /// @param level The slot's level.
+  /// @param slot The slot.
+  void cascade(int level, size_t slot);
+
+  /// Returns the slot covering the given tick on the given level.
+  ///
+  /// @param level The level.
+  /// @param tick The tick.
+  static constexpr size_t get_slot(int level, uint64_t tick) {
+    return (tick >> (level * SLOT_BITS)) & (NUM_SLOTS - 1);
+  }
+};
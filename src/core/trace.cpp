@@ -0,0 +1,113 @@
+// Copyright (c) Tyler Veness
+
+#include "trace.hpp"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <print>
+#include <string>
+#include <string_view>
+
+namespace {
+
+/// Returns a small, stable ID for the calling thread.
+uint32_t current_thread_id() {
+  static std::atomic<uint32_t> next_thread_id = 0;
+  thread_local uint32_t thread_id = next_thread_id++;
+  return thread_id;
+}
+
+}  // namespace
+
+bool Tracer::start(const std::filesystem::path& path, int frames) {
+#ifdef ENABLE_TRACING
+  std::scoped_lock lock{mutex};
+
+  if (is_recording() || frames <= 0) {
+    return false;
+  }
+
+  events.clear();
+  this->path = path;
+  remaining_frames = frames;
+  start_time = std::chrono::steady_clock::now();
+  recording.store(true, std::memory_order_relaxed);
+
+  return true;
+#else
+  static_cast<void>(path);
+  static_cast<void>(frames);
+  return false;
+#endif
+}
+
+void Tracer::begin_frame() {
+  if (!is_recording()) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock{mutex};
+    if (remaining_frames-- > 0) {
+      return;
+    }
+
+    recording.store(false, std::memory_order_relaxed);
+  }
+
+  write();
+}
+
+void Tracer::add_event(std::string_view name,
+                       std::chrono::steady_clock::time_point start_time,
+                       std::chrono::steady_clock::time_point end_time) {
+  uint32_t thread_id = current_thread_id();
+
+  std::scoped_lock lock{mutex};
+  if (is_recording()) {
+    events.emplace_back(name, start_time, end_time, thread_id);
+  }
+}
+
+void Tracer::write() {
+  using microseconds = std::chrono::duration<double, std::micro>;
+
+  std::scoped_lock lock{mutex};
+
+  std::ofstream file{path};
+  if (!file.is_open()) {
+    std::println(stderr, "Failed to open trace file {}", path.string());
+    return;
+  }
+
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto& event = events[i];
+    std::format_to(
+        std::back_inserter(json),
+        "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+        "\"dur\":{:.3f}}}{}\n",
+        event.name, event.thread_id,
+        microseconds{event.start_time - start_time}.count(),
+        microseconds{event.end_time - event.start_time}.count(),
+        i + 1 < events.size() ? "," : "");
+  }
+  json += "]}\n";
+  file << json;
+
+  std::println(stderr, "Wrote {} trace events to {}", events.size(),
+               path.string());
+  events.clear();
+}
+
+Tracer& global_tracer() {
+  static Tracer tracer;
+  return tracer;
+}
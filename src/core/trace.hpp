@@ -0,0 +1,105 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// NB: Trace instrumentation is only compiled in if ENABLE_TRACING is defined
+// (see the ENABLE_TRACING CMake option). Otherwise, TRACE_SCOPE() expands to
+// nothing and Tracer::start() always fails.
+
+/// Records trace events and writes them as Chrome trace-event JSON, which can
+/// be opened in chrome://tracing or https://ui.perfetto.dev.
+class Tracer {
+ public:
+  /// Starts recording trace events.
+  ///
+  /// @param path File the trace is written to once recording finishes.
+  /// @param frames Number of frames to record.
+  /// @return False if tracing was compiled out or a recording is in progress.
+  bool start(const std::filesystem::path& path, int frames);
+
+  /// Returns true if trace events are being recorded.
+  bool is_recording() const {
+    return recording.load(std::memory_order_relaxed);
+  }
+
+  /// Marks the start of a new frame. Once the requested number of frames has
+  /// been recorded, recording stops and the trace is written.
+  void begin_frame();
+
+  /// Records a complete event.
+  ///
+  /// @param name Event name. Must outlive the recording.
+  /// @param start_time Event start time.
+  /// @param end_time Event end time.
+  void add_event(std::string_view name,
+                 std::chrono::steady_clock::time_point start_time,
+                 std::chrono::steady_clock::time_point end_time);
+
+ private:
+  struct Event {
+    std::string_view name;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point end_time;
+    uint32_t thread_id;
+  };
+
+  std::atomic<bool> recording = false;
+
+  std::mutex mutex;
+  std::vector<Event> events;
+  std::filesystem::path path;
+  int remaining_frames = 0;
+  std::chrono::steady_clock::time_point start_time;
+
+  /// Writes recorded events to the trace file.
+  void write();
+};
+
+/// Returns the application-wide tracer.
+Tracer& global_tracer();
+
+/// Records a trace event spanning from construction to destruction.
+class TraceScope {
+ public:
+  /// Starts the event if the application-wide tracer is recording.
+  ///
+  /// @param name Event name. Must outlive the recording.
+  explicit TraceScope(std::string_view name) : name{name} {
+    if (global_tracer().is_recording()) {
+      start_time = std::chrono::steady_clock::now();
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  ~TraceScope() {
+    if (start_time != std::chrono::steady_clock::time_point{}) {
+      global_tracer().add_event(name, start_time,
+                                std::chrono::steady_clock::now());
+    }
+  }
+
+ private:
+  std::string_view name;
+  std::chrono::steady_clock::time_point start_time;
+};
+
+#ifdef ENABLE_TRACING
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+/// Records a trace event with the given name for the rest of the scope.
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__){name}
+#else
+#define TRACE_SCOPE(name)
+#endif
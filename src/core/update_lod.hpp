@@ -0,0 +1,75 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+
+/// How often an entity's simulation is updated, by distance from the view.
+enum class UpdateLod : uint8_t {
+  /// Within the view or close to it. Updated every tick.
+  FULL,
+  /// Beyond the view margin. Updated every REDUCED_UPDATE_PERIOD ticks with a
+  /// proportionally longer time step.
+  REDUCED,
+  /// Near the map edges. Moved along its current velocity every tick and only
+  /// re-steered every EXTRAPOLATED_UPDATE_PERIOD ticks.
+  EXTRAPOLATED
+};
+
+/// Distance in pixels beyond the view edge that still gets full-rate updates.
+/// It's wide enough that entities are back at full rate well before they're
+/// visible.
+constexpr float FULL_UPDATE_MARGIN = 256.f;
+
+/// Distance in pixels beyond the view edge that gets reduced-rate updates.
+constexpr float REDUCED_UPDATE_MARGIN = 1280.f;
+
+/// Ticks between reduced-rate updates.
+constexpr uint8_t REDUCED_UPDATE_PERIOD = 4;
+
+/// Ticks between re-steering extrapolated entities.
+constexpr uint8_t EXTRAPOLATED_UPDATE_PERIOD = 16;
+
+/// Returns the update level of detail for an entity.
+///
+/// @param view_center Center of the view, which follows the player.
+/// @param position Entity position.
+inline UpdateLod select_update_lod(const sf::Vector2f& view_center,
+                                   const sf::Vector2f& position) {
+  // Distance outside the view rectangle along the farther axis
+  float distance = std::max(
+      std::abs(position.x - view_center.x) - SCREEN_DIMS.x / 2.f,
+      std::abs(position.y - view_center.y) - SCREEN_DIMS.y / 2.f);
+
+  if (distance < FULL_UPDATE_MARGIN) {
+    return UpdateLod::FULL;
+  } else if (distance < REDUCED_UPDATE_MARGIN) {
+    return UpdateLod::REDUCED;
+  } else {
+    return UpdateLod::EXTRAPOLATED;
+  }
+}
+
+/// Returns the number of ticks between full updates for the given level of
+/// detail.
+///
+/// @param lod Update level of detail.
+constexpr uint8_t get_update_period(UpdateLod lod) {
+  switch (lod) {
+    case UpdateLod::FULL:
+      return 1;
+    case UpdateLod::REDUCED:
+      return REDUCED_UPDATE_PERIOD;
+    case UpdateLod::EXTRAPOLATED:
+      return EXTRAPOLATED_UPDATE_PERIOD;
+  }
+
+  return 1;
+}
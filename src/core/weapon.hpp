@@ -0,0 +1,137 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "bullet.hpp"
+#include "weapon_type.hpp"
+
+// NB: To add a new weapon type:
+//
+//   * Add enum value to WeaponType.
+//   * Add initial ammo amount to get_initial_ammo().
+//   * Add case to switch-case in Weapon constructor that sets weapon stats.
+//   * Add case to switch-case in Weapon::make_bullet() that returns a new
+//     bullet with the weapon's body shape.
+//   * Add case to switch-case in Renderer::draw_weapon() that draws weapon
+//     symbol, and to bullet_color() for the bullet's color.
+//   * (optional) Add features unique to this weapon type to world.cpp
+//     * Add branch to bullet firing code if there's more than one bullet per
+//       shot.
+//     * Add branch to bullet-zombie collision if there's special handling of
+//       collisions (e.g., chain/area damage).
+
+/// Returns initial ammo for the given weapon.
+constexpr int get_initial_ammo(WeaponType type) {
+  constexpr std::array INITIAL_AMMO{1000, 250, 200, 10, 20, 500, 10};
+  return INITIAL_AMMO[std::to_underlying(type)];
+}
+
+class Weapon {
+ public:
+  WeaponType type;
+  int ammo;
+  float fire_period;
+  float accuracy;
+  float bullet_speed;
+  int bullet_damage;
+
+  /// Constructs a weapon with the default amount of initial ammo.
+  ///
+  /// @param type Weapon type.
+  explicit Weapon(WeaponType type) : type{type}, ammo{get_initial_ammo(type)} {
+    using enum WeaponType;
+
+    switch (type) {
+      case HANDGUN:
+        fire_period = 0.5f;
+        accuracy = 1.f;
+        bullet_speed = 1000.f;
+        bullet_damage = 200;
+        break;
+      case MACHINE_GUN:
+        fire_period = 1.f / 15.f;
+        accuracy = 0.98f;
+        bullet_speed = 2000.f;
+        bullet_damage = 50;
+        break;
+      case FLAMETHROWER:
+        fire_period = 0.02f;
+        accuracy = 0.9f;
+        bullet_speed = 200.f;
+        bullet_damage = 200;
+        break;
+      case LASER:
+        fire_period = 1.f;
+        accuracy = 1.f;
+        bullet_speed = 1000.f;
+        bullet_damage = 2000;
+        break;
+      case SHOTGUN:
+        fire_period = 1.f;
+        accuracy = 0.95f;
+        bullet_speed = 1500.f;
+        bullet_damage = 75;
+        break;
+      case MINIGUN:
+        fire_period = 0.01f;
+        accuracy = 0.9f;
+        bullet_speed = 2500.f;
+        bullet_damage = 100;
+        break;
+      case ROCKET_LAUNCHER:
+        fire_period = 2.f;
+        accuracy = 1.f;
+        bullet_speed = 1000.f;
+        bullet_damage = 2000;
+        break;
+    }
+  }
+
+  /// Constructs a weapon.
+  ///
+  /// @param type Weapon type.
+  /// @param ammo Initial ammo.
+  Weapon(WeaponType type, int ammo) : Weapon(type) { this->ammo = ammo; }
+
+  /// Fires a bullet from the gun.
+  ///
+  /// @param position Initial bullet position.
+  /// @param rotation Bullet rotation as a 2D unit vector.
+  /// @param spread Random angle within the weapon's accuracy to rotate the
+  ///     bullet by.
+  /// @return The bullet instance.
+  Bullet make_bullet(const sf::Vector2f& position, const sf::Vector2f& rotation,
+                     sf::Angle spread) {
+    using enum WeaponType;
+
+    sf::Vector2f velocity = bullet_speed * rotation.rotatedBy(spread);
+
+    switch (type) {
+      case HANDGUN:
+      case MACHINE_GUN:
+      case SHOTGUN:
+        return Bullet{position, velocity, type, bullet_damage,
+                      BulletShape::RECTANGLE, {10.f, 1.f}};
+      case FLAMETHROWER:
+        return Bullet{position, velocity, type, bullet_damage,
+                      BulletShape::CIRCLE, {10.f, 10.f}, 3.f};
+      case LASER:
+        return Bullet{position, velocity, type, bullet_damage,
+                      BulletShape::RECTANGLE, {20.f, 2.f}};
+      case MINIGUN:
+        return Bullet{position, velocity, type, bullet_damage,
+                      BulletShape::RECTANGLE, {20.f, 3.f}};
+      case ROCKET_LAUNCHER:
+        return Bullet{position, velocity, type, bullet_damage,
+                      BulletShape::CONVEX};
+      default:
+        std::unreachable();
+    }
+  }
+};
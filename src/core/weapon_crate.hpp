@@ -0,0 +1,107 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "globals.hpp"
+#include "player.hpp"
+#include "weapon.hpp"
+#include "weapon_type.hpp"
+
+/// Weapon crate entity.
+class WeaponCrate {
+ public:
+  /// Constructs a weapon crate.
+  ///
+  /// @param position Initial position.
+  /// @param type Weapon type the crate contains.
+  /// @param id ID that orders crates by when they were added to the world.
+  WeaponCrate(const sf::Vector2f& position, WeaponType type, uint32_t id)
+      : position{position}, type{type}, ammo{get_initial_ammo(type)}, id{id} {}
+
+  /// Returns the position.
+  const sf::Vector2f& get_position() const { return position; }
+
+  /// Returns the weapon type this crate contains.
+  WeaponType get_type() const { return type; }
+
+  /// Returns the amount of ammunition this crate contains.
+  int get_ammo() const { return ammo; }
+
+  /// Returns the crate's ID.
+  uint32_t get_id() const { return id; }
+
+  /// Returns the crate's lifetime in seconds of simulation time.
+  static constexpr float get_lifetime() { return LIFETIME; }
+
+  /// Returns the time in seconds of simulation time between crate spawns.
+  static constexpr float get_spawn_period() { return SPAWN_PERIOD; }
+
+  /// Returns the size of this crate for collision detection.
+  sf::Vector2f get_size() const { return sf::Vector2f{WIDTH, WIDTH}; }
+
+  /// Returns the width of the crate's body excluding its outline.
+  static constexpr float get_inner_width() { return INNER_WIDTH; }
+
+  /// Returns the thickness of the crate body's outline.
+  static constexpr float get_outer_width() { return OUTER_WIDTH; }
+
+  /// Returns the global bounds for collision detection.
+  sf::FloatRect get_global_bounds() const {
+    return sf::FloatRect{position - get_size() / 2.f, get_size()};
+  }
+
+  /// Spawns a weapon crate with a random weapon near the player.
+  ///
+  /// @param weapon_crates The list of active weapon crates.
+  /// @param player The player entity.
+  /// @param id The new crate's ID.
+  static void spawn(std::vector<WeaponCrate>& weapon_crates,
+                    const Player& player, uint32_t id) {
+    auto& random = global_random(RandomStream::WEAPON_CRATE_SPAWN);
+
+    sf::Vector2f position;
+    do {
+      position = {
+          std::clamp(player.get_position().x +
+                         random.uniform(-SCREEN_DIMS.x / 2.f,
+                                        SCREEN_DIMS.x / 2.f),
+                     WIDTH / 2.f, MAP_DIMS.x - WIDTH / 2.f),
+          std::clamp(player.get_position().y +
+                         random.uniform(-SCREEN_DIMS.y / 2.f,
+                                        SCREEN_DIMS.y / 2.f),
+                     WIDTH / 2.f, MAP_DIMS.y - WIDTH / 2.f)};
+    } while (player.get_global_bounds().contains(position));
+
+    // Any weapon but the handgun
+    weapon_crates.emplace_back(
+        position,
+        static_cast<WeaponType>(1 + random.uniform_int(NUM_WEAPONS - 1)), id);
+  }
+
+ private:
+  static constexpr float INNER_WIDTH = 10.f;
+  static constexpr float OUTER_WIDTH = 4.f;
+  static constexpr float WIDTH = INNER_WIDTH + OUTER_WIDTH;
+
+  /// Lifetime in seconds.
+  static constexpr float LIFETIME = 30.f;
+
+  /// Spawn period in seconds.
+  static constexpr float SPAWN_PERIOD = 10.f;
+
+  sf::Vector2f position;
+
+  WeaponType type;
+  int ammo;
+
+  uint32_t id;
+};
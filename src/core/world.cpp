@@ -0,0 +1,630 @@
+// Copyright (c) Tyler Veness
+
+#include "world.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "bullet.hpp"
+#include "collision_detector.hpp"
+#include "collision_stats.hpp"
+#include "constants.hpp"
+#include "frame_arena.hpp"
+#include "globals.hpp"
+#include "job_system.hpp"
+#include "laser.hpp"
+#include "phase.hpp"
+#include "player.hpp"
+#include "random.hpp"
+#include "random_angle.hpp"
+#include "snapshot.hpp"
+#include "trace.hpp"
+#include "update_lod.hpp"
+#include "weapon_crate.hpp"
+#include "weapon_type.hpp"
+#include "zombie.hpp"
+
+namespace {
+
+/// Runs a collision detector's narrowphase test and counts it.
+///
+/// @param detector The collision detector.
+/// @param shape_pair The shape pair being tested.
+/// @param counts Collision counters to update.
+/// @return True if all shapes collide.
+bool narrowphase_collides(CollisionDetector& detector, ShapePair shape_pair,
+                          CollisionCounts& counts) {
+  bool collides = detector.collides();
+
+  ++counts.narrowphase_tests[std::to_underlying(shape_pair)];
+  counts.solver_iterations += detector.get_iterations();
+  if (detector.get_exit_status() != slp::ExitStatus::SUCCESS) {
+    ++counts.solver_failures;
+  }
+
+  return collides;
+}
+
+/// Returns the distance along a ray from a point in the map to the map's edge.
+///
+/// @param origin Ray origin.
+/// @param direction Ray direction as a unit vector.
+float distance_to_map_edge(const sf::Vector2f& origin,
+                           const sf::Vector2f& direction) {
+  constexpr float INF = std::numeric_limits<float>::infinity();
+
+  float distance_x = INF;
+  if (direction.x > 0.f) {
+    distance_x = (MAP_BOUNDS.position.x + MAP_BOUNDS.size.x - origin.x) /
+                 direction.x;
+  } else if (direction.x < 0.f) {
+    distance_x = (MAP_BOUNDS.position.x - origin.x) / direction.x;
+  }
+
+  float distance_y = INF;
+  if (direction.y > 0.f) {
+    distance_y = (MAP_BOUNDS.position.y + MAP_BOUNDS.size.y - origin.y) /
+                 direction.y;
+  } else if (direction.y < 0.f) {
+    distance_y = (MAP_BOUNDS.position.y - origin.y) / direction.y;
+  }
+
+  return std::max(std::min(distance_x, distance_y), 0.f);
+}
+
+/// Number of bullets per thread pool chunk in bullet -> zombie collision
+/// detection. Narrowphase tests are expensive, so chunks are small.
+constexpr size_t COLLISION_CHUNK_SIZE = 8;
+
+/// Bullet -> zombie hit found by collision detection.
+struct BulletHit {
+  /// Index of the bullet.
+  size_t bullet;
+
+  /// Index of the first zombie the bullet hits.
+  size_t zombie;
+};
+
+/// Hits and collision counters from one chunk of bullets.
+struct CollisionChunk {
+  std::array<BulletHit, COLLISION_CHUNK_SIZE> hits;
+  size_t num_hits = 0;
+  CollisionCounts counts;
+};
+
+/// Returns the index of the first zombie a bullet collides with, if any.
+///
+/// @param bullet The bullet.
+/// @param zombies The zombies.
+/// @param removed Whether each zombie is skipped.
+/// @param first Index of the first zombie to test.
+/// @param counts Collision counters to update.
+std::optional<size_t> find_bullet_hit(const Bullet& bullet,
+                                      std::span<const Zombie> zombies,
+                                      std::span<const uint8_t> removed,
+                                      size_t first, CollisionCounts& counts) {
+  for (size_t i = first; i < zombies.size(); ++i) {
+    if (removed[i]) {
+      continue;
+    }
+
+    const auto& zombie = zombies[i];
+    ++counts.candidate_pairs;
+
+    // If bounding boxes don't intersect, skip more expensive
+    // collision check
+    if (!zombie.get_global_bounds().findIntersection(
+            bullet.get_global_bounds())) {
+      ++counts.aabb_rejects;
+      continue;
+    }
+
+    CollisionDetector detector;
+    detector.add_circle(zombie.get_position(), zombie.get_radius());
+    ShapePair shape_pair;
+    if (bullet.get_shape() == BulletShape::CIRCLE) {
+      detector.add_circle(bullet.get_position(),
+                          bullet.get_global_bounds().size.x);
+      shape_pair = ShapePair::CIRCLE_CIRCLE;
+    } else if (bullet.get_shape() == BulletShape::RECTANGLE) {
+      detector.add_rectangle(bullet.get_position(),
+                             bullet.get_global_bounds().size,
+                             bullet.get_rotation());
+      shape_pair = ShapePair::CIRCLE_RECTANGLE;
+    } else {
+      detector.add_rectangle(bullet.get_position(),
+                             bullet.get_global_bounds().size,
+                             bullet.get_rotation());
+      shape_pair = ShapePair::CIRCLE_CONVEX;
+    }
+
+    bool collides = narrowphase_collides(detector, shape_pair, counts);
+    auto weapon_index = std::to_underlying(bullet.get_type());
+    ++counts.weapon_narrowphase_tests[weapon_index];
+    counts.weapon_solver_iterations[weapon_index] += detector.get_iterations();
+
+    if (collides) {
+      return i;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/// Erases the entity with the given ID from a list sorted by ID, if it's
+/// still there.
+///
+/// @param entities The list of entities.
+/// @param id The entity's ID.
+template <typename T>
+void erase_by_id(T& entities, uint32_t id) {
+  auto it = std::ranges::lower_bound(
+      entities, id, {}, [](const auto& entity) { return entity.get_id(); });
+  if (it != entities.end() && it->get_id() == id) {
+    entities.erase(it);
+  }
+}
+
+}  // namespace
+
+void World::step(float frame_duration, const PlayerInput& input) {
+  TRACE_SCOPE("world step");
+
+  elapsed_time += frame_duration;
+
+  if (input.weapon) {
+    player.switch_weapon(*input.weapon);
+  }
+
+  auto& arena = global_frame_arena();
+  std::pmr::vector<LaserRay> laser_rays{&arena};
+
+  // Weapon crate collisions can overlap bullet -> zombie collisions, so they
+  // count into their own counters
+  CollisionCounts crate_counts;
+
+  auto fire_job = [&] { fire(input, laser_rays); };
+
+  auto move_bullets_job = [&] {
+    for (auto& bullet : bullets) {
+      bullet.update_movement(frame_duration);
+    }
+
+    for (auto& streak : laser_streaks) {
+      streak.age += frame_duration;
+    }
+    std::erase_if(laser_streaks, [](const auto& streak) {
+      return streak.age > LASER_STREAK_LIFETIME;
+    });
+  };
+
+  auto move_player_job = [&] {
+    sf::Vector2f player_direction = input.direction;
+    if (player_direction.x != 0.f || player_direction.y != 0.f) {
+      player_direction /= player_direction.length();
+    }
+    player.update_movement(frame_duration, player_direction, input.sprint);
+  };
+
+  auto move_zombies_job = [&] {
+    flow_field.update(player.get_position());
+    Zombie::update_movement(zombies, frame_duration, player.get_position(),
+                            player.get_velocity(), flow_field,
+                            get_thread_pool());
+  };
+
+  auto run_timers_job = [&] { run_timers(frame_duration); };
+
+  auto spawn_zombies_job = [&] {
+    size_t num_zombies = zombies.size();
+    if (Zombie::spawn(zombies, get_zombie_cap(), horde_config.wave_size,
+                      elapsed_time - zombie_spawn_time)) {
+      zombie_spawn_time = elapsed_time;
+      for (size_t i = num_zombies; i < zombies.size(); ++i) {
+        zombies[i].set_id(next_entity_id++);
+      }
+    }
+  };
+
+  auto collide_bullets_job = [&] {
+    resolve_lasers(laser_rays);
+    collide_bullets_with_zombies();
+  };
+
+  auto collide_weapon_crates_job = [&] {
+    collide_player_with_weapon_crates(crate_counts);
+  };
+
+  auto contact_damage_job = [&] {
+    collide_zombies_with_player(frame_duration);
+  };
+
+  // Each job depends on the earlier jobs that write data it touches, so
+  // results match running them in the order they're added. Jobs that can
+  // overlap touch different entities or different player fields. Zombie
+  // movement and bullet -> zombie collisions both use the thread pool, which
+  // runs one loop at a time, and the frame arena and random streams aren't
+  // synchronized, so their users are ordered too.
+  JobGraph graph{&arena};
+  auto firing = graph.add(Phase::FIRING, fire_job);
+  auto bullet_movement =
+      graph.add(Phase::BULLET_MOVEMENT, move_bullets_job, {firing});
+  auto player_movement =
+      graph.add(Phase::PLAYER_MOVEMENT, move_player_job, {firing});
+  auto zombie_movement =
+      graph.add(Phase::ZOMBIE_MOVEMENT, move_zombies_job, {player_movement});
+  auto timers = graph.add(Phase::TIMERS, run_timers_job,
+                          {bullet_movement, player_movement});
+
+  // Timers and zombie spawning both hand out entity IDs
+  auto spawning = graph.add(Phase::SPAWNING, spawn_zombies_job,
+                            {zombie_movement, timers});
+  auto bullet_collision =
+      graph.add(Phase::BULLET_ZOMBIE_COLLISION, collide_bullets_job, {spawning});
+  graph.add(Phase::WEAPON_CRATE_COLLISION, collide_weapon_crates_job,
+            {timers});
+  graph.add(Phase::CONTACT_DAMAGE, contact_damage_job, {bullet_collision});
+
+  get_job_system().run(graph);
+
+  global_collision_stats().get_current_counts() += crate_counts;
+}
+
+void World::reset() {
+  zombies.clear();
+  bullets.clear();
+  weapon_crates.clear();
+  laser_streaks.clear();
+
+  player = Player{SCREEN_DIMS / 2.f};
+  elapsed_time = 0.f;
+
+  timers.clear();
+  timers.schedule(WeaponCrate::get_spawn_period(),
+                  TimerType::WEAPON_CRATE_SPAWN);
+  zombie_spawn_time = 0.f;
+  next_entity_id = 0;
+}
+
+void World::save(Snapshot& snapshot) const {
+  snapshot.clear();
+  snapshot.write(player);
+  snapshot.write_list(bullets);
+  snapshot.write_list(weapon_crates);
+  snapshot.write_list(zombies);
+  snapshot.write_list(laser_streaks);
+  timers.save(snapshot);
+  snapshot.write(elapsed_time);
+  snapshot.write(zombie_spawn_time);
+  snapshot.write(next_entity_id);
+  for (int i = 0; i < NUM_RANDOM_STREAMS; ++i) {
+    snapshot.write(global_random(static_cast<RandomStream>(i)));
+  }
+}
+
+void World::restore(const Snapshot& snapshot, bool restore_random) {
+  // The flow field and zombie grid are derived from the restored state and
+  // rebuilt when they're next used
+  SnapshotReader reader{snapshot};
+  player = reader.read<Player>();
+  reader.read_list(bullets);
+  reader.read_list(weapon_crates);
+  reader.read_list(zombies);
+  reader.read_list(laser_streaks);
+  timers.restore(reader);
+  elapsed_time = reader.read<float>();
+  zombie_spawn_time = reader.read<float>();
+  next_entity_id = reader.read<uint32_t>();
+  for (int i = 0; i < NUM_RANDOM_STREAMS; ++i) {
+    auto random = reader.read<Random>();
+    if (restore_random) {
+      global_random(static_cast<RandomStream>(i)) = random;
+    }
+  }
+}
+
+void World::add_bullet(Bullet&& bullet) {
+  bullet.set_id(next_entity_id++);
+
+  // Delayed bullets start with a negative age
+  timers.schedule(BULLET_MAX_LIFETIME - bullet.get_age(),
+                  TimerType::BULLET_EXPIRY, bullet.get_id());
+  bullets.emplace_back(std::move(bullet));
+}
+
+void World::run_timers(float frame_duration) {
+  std::pmr::vector<TimerEvent> fired_timers{&global_frame_arena()};
+  timers.advance(frame_duration, fired_timers);
+
+  for (const auto& timer : fired_timers) {
+    switch (timer.type) {
+      case TimerType::BULLET_EXPIRY:
+        erase_by_id(bullets, timer.id);
+        break;
+      case TimerType::WEAPON_CRATE_EXPIRY:
+        erase_by_id(weapon_crates, timer.id);
+        break;
+      case TimerType::WEAPON_CRATE_SPAWN:
+        WeaponCrate::spawn(weapon_crates, player, next_entity_id++);
+        timers.schedule(WeaponCrate::get_lifetime(),
+                        TimerType::WEAPON_CRATE_EXPIRY,
+                        weapon_crates.back().get_id());
+        timers.schedule(WeaponCrate::get_spawn_period(),
+                        TimerType::WEAPON_CRATE_SPAWN);
+        break;
+    }
+  }
+}
+
+void World::fire(const PlayerInput& input,
+                 std::pmr::vector<LaserRay>& laser_rays) {
+  if (!input.fire || !player.try_fire(input.fire_delay)) {
+    return;
+  }
+
+  auto angle = input.aim_target - player.get_position();
+  if (angle.x != 0.f || angle.y != 0.f) {
+    angle /= angle.length();
+  }
+
+  auto& weapon = player.get_current_weapon();
+  auto& random = global_random(RandomStream::BULLET_SPREAD);
+
+  // Bullets fired partway through the step only fly for the rest of it.
+  // Lasers are hitscan, so they don't need this.
+  auto fire_bullet = [&](Bullet bullet) {
+    bullet.delay(input.fire_delay);
+    add_bullet(std::move(bullet));
+  };
+
+  if (weapon.ammo > 0) {
+    if (weapon.type == WeaponType::SHOTGUN) {
+      std::array<float, 15> spreads;
+      fill_random_angles(random, spreads, weapon.accuracy);
+      for (float spread : spreads) {
+        fire_bullet(weapon.make_bullet(player.get_position(), angle,
+                                       sf::radians(spread)));
+      }
+    } else if (weapon.type == WeaponType::LASER) {
+      // Lasers are hitscan, so they travel their whole range at once. Their
+      // range matches how far a bullet of the same speed flies in its
+      // lifetime.
+      laser_rays.push_back(
+          {player.get_position(),
+           angle.rotatedBy(random_angle(random, weapon.accuracy)),
+           weapon.bullet_speed * BULLET_MAX_LIFETIME, weapon.bullet_damage});
+    } else {
+      fire_bullet(weapon.make_bullet(player.get_position(), angle,
+                                     random_angle(random, weapon.accuracy)));
+    }
+
+    --weapon.ammo;
+  }
+}
+
+void World::resolve_lasers(std::pmr::vector<LaserRay>& laser_rays) {
+  if (laser_rays.empty()) {
+    return;
+  }
+
+  auto& counts = global_collision_stats().get_current_counts();
+
+  zombie_grid.build(zombies);
+
+  // Kills append split lasers to the queue, so whole chains resolve in this
+  // pass. Chains end because each split needs a kill, and dead zombies don't
+  // stop rays.
+  for (size_t i = 0; i < laser_rays.size(); ++i) {
+    // Copied since appending can reallocate the queue
+    auto ray = laser_rays[i];
+
+    float range =
+        std::min(ray.range, distance_to_map_edge(ray.origin, ray.direction));
+    auto hit = zombie_grid.raycast(zombies, ray.origin, ray.direction, range);
+    float distance = hit ? hit->distance : range;
+    laser_streaks.push_back(
+        {ray.origin, ray.origin + ray.direction * distance});
+
+    if (!hit) {
+      continue;
+    }
+
+    ++counts.hits;
+    auto& zombie = zombies[hit->zombie_index];
+    zombie.decrement_health(ray.damage);
+    if (zombie.get_health() <= 0.f) {
+      // If zombie dies to laser, split off lower-damage ones from it
+      std::array<float, LASER_SPLIT_COUNT> directions;
+      fill_random_angles(global_random(RandomStream::LASER_SPLIT), directions,
+                         0.f);
+      for (float direction : directions) {
+        laser_rays.push_back(
+            {zombie.get_position(),
+             ray.direction.rotatedBy(sf::radians(direction)), ray.range,
+             ray.damage / 10});
+      }
+    }
+  }
+
+  // Remove the kills so bullets don't collide with them
+  remove_dead_zombies();
+}
+
+void World::collide_bullets_with_zombies() {
+  auto& counts = global_collision_stats().get_current_counts();
+  auto& arena = global_frame_arena();
+
+  // Zombies killed by bullets this frame. They're swept at the end, but
+  // later bullets pass through them.
+  std::pmr::vector<uint8_t> removed(zombies.size(), 0, &arena);
+
+  // Detect each bullet's first hit in parallel. Nothing is modified until
+  // every bullet has been tested, so the chunks can run in any order.
+  size_t num_bullets = bullets.size();
+  std::pmr::vector<CollisionChunk> chunks(
+      (num_bullets + COLLISION_CHUNK_SIZE - 1) / COLLISION_CHUNK_SIZE, &arena);
+  get_thread_pool().parallel_for(
+      num_bullets, COLLISION_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        auto& chunk = chunks[begin / COLLISION_CHUNK_SIZE];
+        for (size_t i = begin; i < end; ++i) {
+          auto zombie =
+              find_bullet_hit(bullets[i], zombies, removed, 0, chunk.counts);
+          if (zombie) {
+            chunk.hits[chunk.num_hits++] = BulletHit{i, *zombie};
+          }
+        }
+      });
+
+  std::pmr::vector<uint8_t> spent(num_bullets, 0, &arena);
+  auto apply_hit = [&](size_t bullet_index, size_t zombie_index) {
+    // Bullets are only appended from here on, which keeps references valid
+    const auto& bullet = bullets[bullet_index];
+    auto& zombie = zombies[zombie_index];
+
+    ++counts.hits;
+    spent[bullet_index] = 1;
+    zombie.decrement_health(bullet.get_damage());
+    if (zombie.get_health() <= 0.f) {
+      removed[zombie_index] = 1;
+
+      if (bullet.get_type() == WeaponType::ROCKET_LAUNCHER) {
+        // If zombie dies to rocket launcher, deal area damage
+        for (size_t i = 0; i < zombies.size(); ++i) {
+          auto& area_zombie = zombies[i];
+          if (!removed[i] &&
+              std::hypot(
+                  area_zombie.get_position().x - bullet.get_position().x,
+                  area_zombie.get_position().y - bullet.get_position().y) <
+                  120.f) {
+            area_zombie.decrement_health(bullet.get_damage());
+          }
+        }
+
+        // Draw explosion radius
+        add_bullet(Bullet(bullet.get_position(), sf::Vector2f{0.f, 0.f},
+                          WeaponType::FLAMETHROWER, bullet.get_damage(),
+                          BulletShape::CIRCLE, sf::Vector2f{120.f, 120.f},
+                          36.f));
+        spent.emplace_back(0);
+      }
+    }
+  };
+
+  // Apply hits serially in bullet order, so results match testing and
+  // applying one bullet at a time
+  for (const auto& chunk : chunks) {
+    counts += chunk.counts;
+
+    for (const auto& hit : std::span{chunk.hits}.first(chunk.num_hits)) {
+      // If an earlier bullet killed this bullet's zombie, the bullet passes
+      // through it to the next zombie it hits, if any
+      std::optional<size_t> zombie = hit.zombie;
+      if (removed[hit.zombie]) {
+        zombie = find_bullet_hit(bullets[hit.bullet], zombies, removed,
+                                 hit.zombie + 1, counts);
+      }
+
+      if (zombie) {
+        apply_hit(hit.bullet, *zombie);
+      }
+    }
+  }
+
+  // Explosions spawned by hits are tested after every other bullet
+  for (size_t i = num_bullets; i < bullets.size(); ++i) {
+    auto zombie = find_bullet_hit(bullets[i], zombies, removed, 0, counts);
+    if (zombie) {
+      apply_hit(i, *zombie);
+    }
+  }
+
+  // Remove spent bullets and ones that left the map. Compacting in place keeps
+  // the list sorted by ID.
+  size_t num_kept = 0;
+  for (size_t i = 0; i < bullets.size(); ++i) {
+    if (!spent[i] && MAP_BOUNDS.contains(bullets[i].get_position())) {
+      if (num_kept != i) {
+        bullets[num_kept] = std::move(bullets[i]);
+      }
+      ++num_kept;
+    }
+  }
+  bullets.erase(bullets.begin() + num_kept, bullets.end());
+
+  // Remove zombies killed by bullets or collateral damage
+  remove_dead_zombies();
+}
+
+void World::remove_dead_zombies() {
+  auto& counts = global_collision_stats().get_current_counts();
+
+  std::erase_if(zombies, [&](const auto& zombie) -> bool {
+    if (zombie.get_health() <= 0.f) {
+      ++counts.kills;
+      player.increment_xp(zombie.get_xp());
+      return true;
+    } else {
+      return false;
+    }
+  });
+}
+
+void World::collide_player_with_weapon_crates(CollisionCounts& counts) {
+  for (auto it = weapon_crates.begin(); it != weapon_crates.end();) {
+    auto& crate = *it;
+    ++counts.candidate_pairs;
+
+    // If bounding boxes don't intersect, skip more expensive
+    // collision check
+    if (!player.get_global_bounds().findIntersection(
+            crate.get_global_bounds())) {
+      ++counts.aabb_rejects;
+      ++it;
+      continue;
+    }
+
+    CollisionDetector detector;
+    detector.add_circle(player.get_position(), player.get_radius());
+    detector.add_rectangle(crate.get_position(), crate.get_size(),
+                           sf::radians(0.f));
+
+    // If player collided with weapon crate, pick it up
+    if (narrowphase_collides(detector, ShapePair::CIRCLE_RECTANGLE, counts)) {
+      player.get_weapon(crate.get_type()).ammo += crate.get_ammo();
+      player.switch_weapon(crate.get_type());
+
+      it = weapon_crates.erase(it);
+      continue;
+    }
+
+    ++it;
+  }
+}
+
+void World::collide_zombies_with_player(float frame_duration) {
+  for (auto& zombie : zombies) {
+    // Zombies updated at a reduced rate are too far away to touch the player
+    if (zombie.get_update_lod() != UpdateLod::FULL) {
+      continue;
+    }
+
+    // If zombie intersects player, inflict damage to player
+    if (std::hypot(zombie.get_position().x - player.get_position().x,
+                   zombie.get_position().y - player.get_position().y) <
+        player.get_radius() + zombie.get_radius()) {
+      player.decrement_health(100.f * frame_duration);
+    }
+  }
+}
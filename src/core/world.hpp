@@ -0,0 +1,265 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "bullet.hpp"
+#include "collision_stats.hpp"
+#include "constants.hpp"
+#include "flow_field.hpp"
+#include "horde_config.hpp"
+#include "job_system.hpp"
+#include "laser.hpp"
+#include "player.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+#include "weapon_crate.hpp"
+#include "weapon_type.hpp"
+#include "zombie.hpp"
+#include "zombie_grid.hpp"
+
+/// Player input sampled for one simulation step.
+struct PlayerInput {
+  /// The direction the player will move. It's normalized before use.
+  sf::Vector2f direction;
+
+  /// Whether the player will attempt to sprint.
+  bool sprint = false;
+
+  /// Whether the player is holding the fire button, or pressed it during the
+  /// step.
+  bool fire = false;
+
+  /// Seconds into the step at which the fire button was pressed, or 0 if it
+  /// was already held. Shots fired by the press are timed from it.
+  float fire_delay = 0.f;
+
+  /// The point in world coordinates the player is aiming at.
+  sf::Vector2f aim_target;
+
+  /// The weapon to switch to before firing, if any.
+  std::optional<WeaponType> weapon;
+};
+
+/// Bytes of memory held per entity type.
+struct MemoryFootprint {
+  /// Bytes held by the player.
+  size_t player = 0;
+
+  /// Bytes held by bullets. Excludes deque block slack.
+  size_t bullets = 0;
+
+  /// Bytes held by zombies, including unused capacity.
+  size_t zombies = 0;
+
+  /// Bytes held by weapon crates, including unused capacity.
+  size_t weapon_crates = 0;
+};
+
+/// Game simulation state and rules, independent of rendering.
+class World {
+ public:
+  /// Constructs a World with the default horde size limits.
+  World() {
+    reserve_horde_storage();
+    timers.schedule(WeaponCrate::get_spawn_period(),
+                    TimerType::WEAPON_CRATE_SPAWN);
+  }
+
+  /// Steps simulation forward by one frame.
+  ///
+  /// @param frame_duration Frame duration in seconds.
+  /// @param input Player input for this frame.
+  void step(float frame_duration, const PlayerInput& input);
+
+  /// Resets the world to the start of a new game.
+  void reset();
+
+  /// Replaces a snapshot's contents with the complete simulation state,
+  /// including the application-wide random streams.
+  ///
+  /// @param snapshot The snapshot.
+  void save(Snapshot& snapshot) const;
+
+  /// Restores the simulation state from a snapshot written by save(). The
+  /// horde and thread settings are kept.
+  ///
+  /// @param snapshot The snapshot.
+  /// @param restore_random Whether to also restore the application-wide random
+  ///   streams. Leave them be to replay from a checkpoint with different
+  ///   randomness.
+  void restore(const Snapshot& snapshot, bool restore_random = true);
+
+  /// Returns the player entity.
+  Player& get_player() { return player; }
+
+  /// Returns the player entity.
+  const Player& get_player() const { return player; }
+
+  /// Returns the list of active bullets.
+  const std::deque<Bullet>& get_bullets() const { return bullets; }
+
+  /// Returns the streaks left by recently resolved lasers.
+  const std::vector<LaserStreak>& get_laser_streaks() const {
+    return laser_streaks;
+  }
+
+  /// Returns the list of active zombies.
+  const std::vector<Zombie>& get_zombies() const { return zombies; }
+
+  /// Returns the list of active weapon crates.
+  const std::vector<WeaponCrate>& get_weapon_crates() const {
+    return weapon_crates;
+  }
+
+  /// Returns the flow field zombies follow toward the player.
+  FlowField& get_flow_field() { return flow_field; }
+
+  /// Returns the flow field zombies follow toward the player.
+  const FlowField& get_flow_field() const { return flow_field; }
+
+  /// Sets the horde size limits. Storage that scales with the horde is
+  /// reserved for the maximum up front, so it never reallocates while the
+  /// horde grows.
+  ///
+  /// @param horde_config The horde size limits.
+  void set_horde_config(const HordeConfig& horde_config) {
+    this->horde_config = horde_config;
+    reserve_horde_storage();
+  }
+
+  /// Returns the horde size limits.
+  const HordeConfig& get_horde_config() const { return horde_config; }
+
+  /// Returns the current zombie cap.
+  uint32_t get_zombie_cap() const {
+    return horde_config.get_cap(player.get_xp(), elapsed_time);
+  }
+
+  /// Sets the thread pool used for parallel updates. Worlds use the global
+  /// thread pool until this is called.
+  ///
+  /// @param thread_pool The thread pool. Pass one with a single thread for
+  ///   fully serial updates.
+  void set_thread_pool(ThreadPool& thread_pool) {
+    this->thread_pool = &thread_pool;
+  }
+
+  /// Sets the job system that runs each step's phases. Worlds use the global
+  /// job system until this is called.
+  ///
+  /// @param job_system The job system. Pass one with a single thread to run
+  ///   phases one at a time.
+  void set_job_system(JobSystem& job_system) {
+    this->job_system = &job_system;
+  }
+
+  /// Returns the bytes of memory held per entity type.
+  MemoryFootprint get_memory_footprint() const {
+    return {sizeof(Player), bullets.size() * sizeof(Bullet),
+            zombies.capacity() * sizeof(Zombie),
+            weapon_crates.capacity() * sizeof(WeaponCrate)};
+  }
+
+ private:
+  std::deque<Bullet> bullets;
+  std::vector<WeaponCrate> weapon_crates;
+  Player player{SCREEN_DIMS / 2.f};
+  std::vector<Zombie> zombies;
+  FlowField flow_field;
+
+  std::vector<LaserStreak> laser_streaks;
+  ZombieGrid zombie_grid;
+
+  HordeConfig horde_config;
+
+  /// Seconds of simulation time since the game started.
+  float elapsed_time = 0.f;
+
+  /// Lifetimes and spawn cadences, driven by simulation time so they freeze
+  /// while the game is paused.
+  TimerWheel timers;
+
+  /// Simulation time in seconds of the last zombie wave.
+  float zombie_spawn_time = 0.f;
+
+  /// ID for the next bullet, weapon crate or zombie. IDs only grow, so the
+  /// lists stay sorted by ID.
+  uint32_t next_entity_id = 0;
+
+  /// Thread pool and job system, or null to use the global ones. They're only
+  /// resolved when stepping, so a World given its own never starts the global
+  /// workers.
+  ThreadPool* thread_pool = nullptr;
+  JobSystem* job_system = nullptr;
+
+  /// Returns the thread pool used for parallel updates.
+  ThreadPool& get_thread_pool() const {
+    return thread_pool != nullptr ? *thread_pool : global_thread_pool();
+  }
+
+  /// Returns the job system that runs each step's phases.
+  JobSystem& get_job_system() const {
+    return job_system != nullptr ? *job_system : global_job_system();
+  }
+
+  /// Reserves zombie, zombie grid, and laser streak storage for the maximum
+  /// horde size.
+  void reserve_horde_storage() {
+    zombies.reserve(horde_config.max_zombies);
+    zombie_grid.reserve(horde_config.max_zombies);
+
+    // Every laser split off a chain needs a kill, so a horde's worth of
+    // streaks covers a chain through the whole horde
+    laser_streaks.reserve(horde_config.max_zombies);
+  }
+
+  /// Adds a bullet and schedules its expiry.
+  ///
+  /// @param bullet The bullet.
+  void add_bullet(Bullet&& bullet);
+
+  /// Advances timers and handles the ones that fire.
+  ///
+  /// @param frame_duration Frame duration in seconds.
+  void run_timers(float frame_duration);
+
+  /// Fires the player's current weapon toward the aim target if possible.
+  ///
+  /// @param input Player input for this frame.
+  /// @param laser_rays Lasers fired this frame, resolved as rays during
+  ///   collision checks.
+  void fire(const PlayerInput& input, std::pmr::vector<LaserRay>& laser_rays);
+
+  /// Traces lasers through the zombies and applies their damage, including
+  /// lasers split off by kills.
+  ///
+  /// @param laser_rays Lasers fired this frame. Split lasers are appended.
+  void resolve_lasers(std::pmr::vector<LaserRay>& laser_rays);
+
+  /// Checks for bullet -> zombie collisions and applies their damage.
+  void collide_bullets_with_zombies();
+
+  /// Removes zombies with no health left and awards their XP.
+  void remove_dead_zombies();
+
+  /// Checks for player -> weapon crate collisions.
+  ///
+  /// @param counts Collision counters to update.
+  void collide_player_with_weapon_crates(CollisionCounts& counts);
+
+  /// Checks for zombie -> player collisions and inflicts contact damage.
+  ///
+  /// @param frame_duration Frame duration in seconds.
+  void collide_zombies_with_player(float frame_duration);
+};
@@ -0,0 +1,275 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "flow_field.hpp"
+#include "globals.hpp"
+#include "thread_pool.hpp"
+#include "update_lod.hpp"
+#include "zombie_spawning.hpp"
+#include "zombie_steering.hpp"
+
+/// Zombie type.
+enum class ZombieType { Small, Big };
+
+/// Zombie entity.
+class Zombie {
+ public:
+  /// Constructs a zombie.
+  ///
+  /// @param position Initial position.
+  /// @param type Zombie type.
+  Zombie(const sf::Vector2f& position, ZombieType type) {
+    this->position = position;
+
+    switch (type) {
+      case ZombieType::Small:
+        velocity = {25.f, 0.f};
+
+        health = SMALL_MAX_HEALTH;
+        max_health = SMALL_MAX_HEALTH;
+        xp = 100;
+        break;
+      case ZombieType::Big:
+        velocity = {50.f, 0.f};
+
+        health = BIG_MAX_HEALTH;
+        max_health = BIG_MAX_HEALTH;
+        xp = 300;
+        break;
+    }
+  }
+
+  Zombie(Zombie&&) = default;
+  Zombie& operator=(Zombie&&) = default;
+
+  /// Sets the position.
+  ///
+  /// @param position The position.
+  void set_position(const sf::Vector2f& position) { this->position = position; }
+
+  /// Returns the position.
+  const sf::Vector2f& get_position() const { return position; }
+
+  /// Returns the velocity.
+  const sf::Vector2f& get_velocity() const { return velocity; }
+
+  /// Returns the zombie's health.
+  float get_health() const { return health; }
+
+  /// Returns the zombie's maximum health.
+  float get_max_health() const { return max_health; }
+
+  /// Decrements the zombie's health by the given amount.
+  ///
+  /// @param decrement The amount to decrement.
+  void decrement_health(float decrement) { health -= decrement; }
+
+  /// Returns the amount of experience killing this zombie would award.
+  uint32_t get_xp() const { return xp; }
+
+  /// Returns the zombie's radius for collision detection.
+  float get_radius() const { return get_radius(max_health); }
+
+  /// Returns the radius of a zombie with the given maximum health.
+  ///
+  /// @param max_health The zombie's maximum health.
+  static constexpr float get_radius(float max_health) {
+    return max_health / 10.f;
+  }
+
+  /// Returns the global bounds for collision detection.
+  sf::FloatRect get_global_bounds() const {
+    return sf::FloatRect{position - sf::Vector2f{get_radius(), get_radius()},
+                         sf::Vector2f{2.f * get_radius(), 2.f * get_radius()}};
+  }
+
+  /// Returns the zombie's ID, which orders zombies by when they spawned.
+  uint32_t get_id() const { return id; }
+
+  /// Sets the zombie's ID.
+  ///
+  /// @param id The ID.
+  void set_id(uint32_t id) { this->id = id; }
+
+  /// Returns the update level of detail from the last movement update.
+  UpdateLod get_update_lod() const { return update_lod; }
+
+  /// Steps simulation forward by one frame for all zombies.
+  ///
+  /// Zombies far from the view are steered less often (see UpdateLod). Zombies
+  /// due for steering are copied into structure-of-arrays chunks for the
+  /// vectorized steering kernel. Each zombie's update only reads its own
+  /// state, so the result is bit-identical to a serial loop no matter how the
+  /// work is split.
+  ///
+  /// @param zombies The list of active zombies.
+  /// @param frame_duration Frame duration in seconds.
+  /// @param player_position Player position. The view is centered on it.
+  /// @param player_velocity Player velocity.
+  /// @param flow_field Flow field toward the player.
+  /// @param thread_pool Thread pool to split the update across.
+  static void update_movement(std::span<Zombie> zombies, float frame_duration,
+                              const sf::Vector2f& player_position,
+                              const sf::Vector2f& player_velocity,
+                              const FlowField& flow_field,
+                              ThreadPool& thread_pool) {
+    const PursuitTarget target{player_position, player_velocity};
+
+    thread_pool.parallel_for(
+        zombies.size(), MOVEMENT_CHUNK_SIZE, [&](size_t begin, size_t end) {
+          SteeringChunk chunk;
+          std::array<Zombie*, MOVEMENT_CHUNK_SIZE> steered;
+
+          for (size_t i = begin; i < end; ++i) {
+            auto& zombie = zombies[i];
+            zombie.update_lod =
+                select_update_lod(player_position, zombie.position);
+            zombie.lod_elapsed += frame_duration;
+            ++zombie.lod_ticks;
+
+            if (zombie.lod_ticks < get_update_period(zombie.update_lod)) {
+              if (zombie.update_lod == UpdateLod::EXTRAPOLATED) {
+                zombie.extrapolate();
+              }
+              continue;
+            }
+
+            // Steer with all the time elapsed since the last update
+            size_t n = chunk.count++;
+            steered[n] = &zombie;
+            chunk.x[n] = zombie.position.x;
+            chunk.y[n] = zombie.position.y;
+            chunk.velocity_x[n] = zombie.velocity.x;
+            chunk.velocity_y[n] = zombie.velocity.y;
+            chunk.radius[n] = zombie.get_radius();
+            chunk.frame_duration[n] = zombie.lod_elapsed;
+
+            const auto& flow = flow_field.get_direction(zombie.position);
+            chunk.flow_x[n] = flow.x;
+            chunk.flow_y[n] = flow.y;
+
+            zombie.lod_ticks = 0;
+            zombie.lod_elapsed = 0.f;
+          }
+
+          steer_zombies(target, chunk);
+
+          for (size_t n = 0; n < chunk.count; ++n) {
+            auto& zombie = *steered[n];
+            zombie.position = {chunk.x[n], chunk.y[n]};
+            zombie.velocity = {chunk.velocity_x[n], chunk.velocity_y[n]};
+          }
+        });
+  }
+
+  /// Spawns a wave of zombies at the edge of the map.
+  ///
+  /// Spawn positions are generated in batches by a vectorized kernel, then
+  /// appended to the list. Reserve the list for the zombie cap so large waves
+  /// don't reallocate it.
+  ///
+  /// @param zombies The list of active zombies.
+  /// @param max_zombies The current zombie cap. Waves spawn faster the further
+  ///   below it the horde is.
+  /// @param wave_size The maximum number of zombies to spawn at once.
+  /// @param time_since_spawn Simulation time in seconds since the last wave.
+  /// @return True if a wave spawned.
+  static bool spawn(std::vector<Zombie>& zombies, uint32_t max_zombies,
+                    uint32_t wave_size, float time_since_spawn) {
+    // Stop spawning zombies if at max
+    if (zombies.size() >= max_zombies) {
+      return false;
+    }
+
+    // Don't spawn zombies until timer has elapsed. The wait shrinks as the
+    // horde does, so it can't be scheduled up front.
+    if (time_since_spawn < SPAWN_PERIOD * zombies.size() / max_zombies) {
+      return false;
+    }
+
+    size_t remaining =
+        std::min<size_t>(wave_size, max_zombies - zombies.size());
+    auto& random = global_random(RandomStream::ZOMBIE_SPAWN);
+    SpawnBatch batch;
+    while (remaining > 0) {
+      batch.count = std::min(remaining, SpawnBatch::CAPACITY);
+      random.fill(std::span{batch.placement_bits}.first(batch.count));
+      random.fill(std::span{batch.type_bits}.first(batch.count));
+
+      place_spawns(batch, get_radius(SMALL_MAX_HEALTH),
+                   get_radius(BIG_MAX_HEALTH));
+
+      for (size_t i = 0; i < batch.count; ++i) {
+        zombies.emplace_back(sf::Vector2f{batch.x[i], batch.y[i]},
+                             batch.big[i] ? ZombieType::Big : ZombieType::Small);
+      }
+
+      remaining -= batch.count;
+    }
+
+    return true;
+  }
+
+ private:
+  /// Spawn period in seconds
+  static constexpr float SPAWN_PERIOD = 0.5f;
+
+  /// Maximum health of small zombies.
+  static constexpr float SMALL_MAX_HEALTH = 200.f;
+
+  /// Maximum health of big zombies.
+  static constexpr float BIG_MAX_HEALTH = 500.f;
+
+  /// Number of zombies per thread pool chunk in the movement update.
+  static constexpr size_t MOVEMENT_CHUNK_SIZE = SteeringChunk::CAPACITY;
+
+  /// Moves the zombie along its current velocity by the pending simulation
+  /// time if it stays within the map.
+  void extrapolate() {
+    const sf::FloatRect ZOMBIE_BOUNDS{
+        MAP_BOUNDS.position + sf::Vector2f{get_radius(), get_radius()},
+        MAP_BOUNDS.size - sf::Vector2f{get_radius(), get_radius()}};
+
+    sf::Vector2f next_position = position + velocity * lod_elapsed;
+    if (ZOMBIE_BOUNDS.contains(next_position)) {
+      position = next_position;
+    }
+    lod_elapsed = 0.f;
+  }
+
+  sf::Vector2f position;
+  sf::Vector2f velocity;
+
+  /// Zombie's current health.
+  float health;
+
+  /// Zombie's maximum health.
+  float max_health;
+
+  /// XP this zombie is worth if killed.
+  uint32_t xp;
+
+  uint32_t id = 0;
+
+  /// Update level of detail from the last movement update.
+  UpdateLod update_lod = UpdateLod::FULL;
+
+  /// Ticks since the zombie was last steered.
+  uint8_t lod_ticks = 0;
+
+  /// Simulation time in seconds the zombie hasn't moved by yet.
+  float lod_elapsed = 0.f;
+};
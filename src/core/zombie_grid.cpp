@@ -0,0 +1,153 @@
+// Copyright (c) Tyler Veness
+
+#include "zombie_grid.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+#include "trace.hpp"
+#include "zombie.hpp"
+
+ZombieGrid::ZombieGrid()
+    : size{static_cast<int>(std::ceil(MAP_BOUNDS.size.x / CELL_SIZE)),
+           static_cast<int>(std::ceil(MAP_BOUNDS.size.y / CELL_SIZE))},
+      cell_starts(static_cast<size_t>(size.x) * size.y + 1, 0) {}
+
+void ZombieGrid::build(std::span<const Zombie> zombies) {
+  TRACE_SCOPE("zombie grid build");
+
+  // Count each cell's zombies, then turn the counts into each cell's end
+  // offset with a prefix sum
+  std::fill(cell_starts.begin(), cell_starts.end(), 0);
+  for (const auto& zombie : zombies) {
+    sf::Vector2i min;
+    sf::Vector2i max;
+    get_cell_range(zombie, min, max);
+    for (int y = min.y; y <= max.y; ++y) {
+      for (int x = min.x; x <= max.x; ++x) {
+        ++cell_starts[get_index({x, y})];
+      }
+    }
+  }
+  for (size_t i = 1; i < cell_starts.size(); ++i) {
+    cell_starts[i] += cell_starts[i - 1];
+  }
+
+  // Fill each cell from its end, which leaves its offset at its start.
+  // Iterating in reverse keeps each cell's zombies in ascending order.
+  cell_zombies.resize(cell_starts.back());
+  for (size_t i = zombies.size(); i-- > 0;) {
+    sf::Vector2i min;
+    sf::Vector2i max;
+    get_cell_range(zombies[i], min, max);
+    for (int y = min.y; y <= max.y; ++y) {
+      for (int x = min.x; x <= max.x; ++x) {
+        cell_zombies[--cell_starts[get_index({x, y})]] =
+            static_cast<uint32_t>(i);
+      }
+    }
+  }
+}
+
+std::optional<RayHit> ZombieGrid::raycast(std::span<const Zombie> zombies,
+                                          const sf::Vector2f& origin,
+                                          const sf::Vector2f& direction,
+                                          float max_distance) const {
+  constexpr float INF = std::numeric_limits<float>::infinity();
+
+  sf::Vector2i cell{
+      std::clamp(static_cast<int>(std::floor(origin.x / CELL_SIZE)), 0,
+                 size.x - 1),
+      std::clamp(static_cast<int>(std::floor(origin.y / CELL_SIZE)), 0,
+                 size.y - 1)};
+  sf::Vector2i step{direction.x < 0.f ? -1 : 1, direction.y < 0.f ? -1 : 1};
+
+  // Distances along the ray to the next vertical and horizontal cell
+  // boundaries, and between consecutive ones
+  float next_x = direction.x != 0.f
+                     ? ((cell.x + (step.x > 0)) * CELL_SIZE - origin.x) /
+                           direction.x
+                     : INF;
+  float next_y = direction.y != 0.f
+                     ? ((cell.y + (step.y > 0)) * CELL_SIZE - origin.y) /
+                           direction.y
+                     : INF;
+  float delta_x = direction.x != 0.f ? CELL_SIZE / std::abs(direction.x) : INF;
+  float delta_y = direction.y != 0.f ? CELL_SIZE / std::abs(direction.y) : INF;
+
+  while (true) {
+    float exit = std::min({next_x, next_y, max_distance});
+
+    // Only hits before the ray leaves this cell are accepted. Every point the
+    // ray passes before then lies in this cell or an earlier one, so no
+    // unvisited zombie can be nearer.
+    std::optional<RayHit> hit;
+    for (uint32_t i = cell_starts[get_index(cell)];
+         i < cell_starts[get_index(cell) + 1]; ++i) {
+      size_t index = cell_zombies[i];
+      const auto& zombie = zombies[index];
+      if (zombie.get_health() <= 0.f) {
+        continue;
+      }
+
+      // Solve |origin + t direction - center| = radius for the nearest t ≥ 0
+      auto offset = origin - zombie.get_position();
+      float radius = zombie.get_radius();
+      float b = offset.dot(direction);
+      float c = offset.lengthSquared() - radius * radius;
+      if (c > 0.f && b > 0.f) {
+        // The ray starts outside the zombie and points away from it
+        continue;
+      }
+      float discriminant = b * b - c;
+      if (discriminant < 0.f) {
+        continue;
+      }
+      float distance = std::max(-b - std::sqrt(discriminant), 0.f);
+
+      if (distance <= exit && (!hit || distance < hit->distance)) {
+        hit = RayHit{index, distance};
+      }
+    }
+
+    if (hit || exit >= max_distance) {
+      return hit;
+    }
+
+    if (next_x < next_y) {
+      cell.x += step.x;
+      next_x += delta_x;
+    } else {
+      cell.y += step.y;
+      next_y += delta_y;
+    }
+
+    if (cell.x < 0 || cell.x >= size.x || cell.y < 0 || cell.y >= size.y) {
+      return std::nullopt;
+    }
+  }
+}
+
+void ZombieGrid::get_cell_range(const Zombie& zombie, sf::Vector2i& min,
+                                sf::Vector2i& max) const {
+  auto position = zombie.get_position();
+  float radius = zombie.get_radius();
+
+  min = {std::clamp(static_cast<int>((position.x - radius) / CELL_SIZE), 0,
+                    size.x - 1),
+         std::clamp(static_cast<int>((position.y - radius) / CELL_SIZE), 0,
+                    size.y - 1)};
+  max = {std::clamp(static_cast<int>((position.x + radius) / CELL_SIZE), 0,
+                    size.x - 1),
+         std::clamp(static_cast<int>((position.y + radius) / CELL_SIZE), 0,
+                    size.y - 1)};
+}
@@ -0,0 +1,95 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "zombie.hpp"
+
+/// Ray intersection with a zombie.
+struct RayHit {
+  /// Index of the zombie that was hit.
+  size_t zombie_index;
+
+  /// Distance along the ray to the zombie's edge, or zero if the ray starts
+  /// inside it.
+  float distance;
+};
+
+/// Uniform grid over the map that indexes zombies by the cells their bounds
+/// overlap, for ray queries.
+///
+/// Cells are stored in compressed sparse row layout: one flat array of zombie
+/// indices sorted by cell, plus each cell's offset into it. Storage only grows,
+/// so rebuilding for a steady horde doesn't allocate.
+class ZombieGrid {
+ public:
+  /// Cell side length in pixels. It's at least the biggest zombie diameter, so
+  /// each zombie overlaps at most four cells.
+  static constexpr float CELL_SIZE = 100.f;
+
+  /// Constructs an empty ZombieGrid covering the map.
+  ZombieGrid();
+
+  /// Reserves storage for indexing the given number of zombies, so builds
+  /// don't allocate until the horde grows past it.
+  ///
+  /// @param num_zombies The number of zombies.
+  void reserve(size_t num_zombies) {
+    // Each zombie overlaps at most four cells
+    cell_zombies.reserve(num_zombies * 4);
+  }
+
+  /// Indexes the given zombies. Indices returned by raycast() refer to this
+  /// list.
+  ///
+  /// @param zombies The zombies.
+  void build(std::span<const Zombie> zombies);
+
+  /// Returns the first living zombie along a ray, if any.
+  ///
+  /// Cells are visited in order along the ray with a DDA traversal, so the
+  /// search stops at the first cell containing a hit.
+  ///
+  /// @param zombies The zombies passed to build(). Zombies with no health left
+  ///   are skipped, so kills made since the build don't block rays.
+  /// @param origin Ray origin.
+  /// @param direction Ray direction as a unit vector.
+  /// @param max_distance Maximum hit distance along the ray.
+  std::optional<RayHit> raycast(std::span<const Zombie> zombies,
+                                const sf::Vector2f& origin,
+                                const sf::Vector2f& direction,
+                                float max_distance) const;
+
+ private:
+  sf::Vector2i size;
+
+  /// Offset of each cell's first zombie index in cell_zombies, plus a final
+  /// entry holding the total.
+  std::vector<uint32_t> cell_starts;
+
+  /// Zombie indices sorted by cell.
+  std::vector<uint32_t> cell_zombies;
+
+  /// Returns the range of cells the given zombie's bounds overlap.
+  ///
+  /// @param zombie The zombie.
+  /// @param min Minimum cell.
+  /// @param max Maximum cell, inclusive.
+  void get_cell_range(const Zombie& zombie, sf::Vector2i& min,
+                      sf::Vector2i& max) const;
+
+  /// Returns the index of the given cell in cell_starts.
+  ///
+  /// @param cell The cell.
+  size_t get_index(const sf::Vector2i& cell) const {
+    return static_cast<size_t>(cell.y) * size.x + cell.x;
+  }
+};
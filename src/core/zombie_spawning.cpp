@@ -0,0 +1,39 @@
+// Copyright (c) Tyler Veness
+
+#include "zombie_spawning.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "constants.hpp"
+
+void place_spawns(SpawnBatch& batch, float small_radius, float big_radius) {
+  // ⌈2³²/10⌉, so random bits below it are big with probability 1/10
+  constexpr uint32_t BIG_THRESHOLD = 429'496'730u;
+
+  const float map_width = MAP_DIMS.x;
+  const float map_height = MAP_DIMS.y;
+
+  for (size_t i = 0; i < batch.count; ++i) {
+    bool big = batch.type_bits[i] < BIG_THRESHOLD;
+    float radius = big ? big_radius : small_radius;
+
+    // The low two bits pick the edge (0 = right, 1 = top, 2 = left,
+    // 3 = bottom) and the high 24 bits give a uniform fraction along it
+    uint32_t bits = batch.placement_bits[i];
+    uint32_t edge = bits & 3u;
+    float fraction =
+        static_cast<float>(static_cast<int32_t>(bits >> 8)) * 0x1p-24f;
+
+    // Vertical edges run along y and horizontal edges along x
+    bool vertical = (edge & 1u) == 0u;
+    float edge_length = vertical ? map_height : map_width;
+    float along = radius + fraction * (edge_length - 2.f * radius);
+
+    float x = edge == 0u ? map_width - radius : radius;
+    float y = edge == 1u ? radius : map_height - radius;
+    batch.x[i] = vertical ? x : along;
+    batch.y[i] = vertical ? along : y;
+    batch.big[i] = big;
+  }
+}
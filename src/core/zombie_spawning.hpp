@@ -0,0 +1,46 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+/// Zombie spawns generated in structure-of-arrays layout.
+struct SpawnBatch {
+  /// Maximum number of zombies per batch.
+  static constexpr size_t CAPACITY = 256;
+
+  /// Number of zombies in the batch.
+  size_t count = 0;
+
+  /// Uniformly distributed random bits that pick each zombie's map edge and
+  /// its position along it.
+  std::array<uint32_t, CAPACITY> placement_bits;
+
+  /// Uniformly distributed random bits that pick each zombie's type.
+  std::array<uint32_t, CAPACITY> type_bits;
+
+  /// Spawn x positions.
+  std::array<float, CAPACITY> x;
+
+  /// Spawn y positions.
+  std::array<float, CAPACITY> y;
+
+  /// Whether each zombie is big (1 in 10) instead of small. It's wider than a
+  /// bool because byte stores may alias the other arrays, which would stop
+  /// the compiler from vectorizing without runtime overlap checks.
+  std::array<uint32_t, CAPACITY> big;
+};
+
+/// Picks zombie types and places zombies at uniformly random points along a
+/// uniformly random map edge, inset by their radius.
+///
+/// The loop has no branches, so the compiler vectorizes it.
+///
+/// @param batch Spawns with their random bits filled in. Their positions and
+///   types are written in place.
+/// @param small_radius Radius of small zombies.
+/// @param big_radius Radius of big zombies.
+void place_spawns(SpawnBatch& batch, float small_radius, float big_radius);
@@ -0,0 +1,95 @@
+// Copyright (c) Tyler Veness
+
+#include "zombie_steering.hpp"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "constants.hpp"
+
+PursuitTarget::PursuitTarget(const sf::Vector2f& player_position,
+                             const sf::Vector2f& player_velocity)
+    : player_position{player_position},
+      player_speed{player_velocity.length()},
+      player_direction{player_speed > 0.f ? player_velocity / player_speed
+                                          : sf::Vector2f{}} {}
+
+void steer_zombies(const PursuitTarget& target, SteeringChunk& chunk) {
+  // Copy the per-frame terms so the compiler knows the stores below can't
+  // change them
+  const float player_x = target.player_position.x;
+  const float player_y = target.player_position.y;
+  const float player_speed = target.player_speed;
+  const float player_cos = target.player_direction.x;
+  const float player_sin = target.player_direction.y;
+
+  auto& x = chunk.x;
+  auto& y = chunk.y;
+  auto& velocity_x = chunk.velocity_x;
+  auto& velocity_y = chunk.velocity_y;
+  const auto& radius = chunk.radius;
+  const auto& frame_duration = chunk.frame_duration;
+  const auto& flow_x = chunk.flow_x;
+  const auto& flow_y = chunk.flow_y;
+
+  for (size_t i = 0; i < chunk.count; ++i) {
+    float position_x = x[i];
+    float position_y = y[i];
+    float zombie_speed = std::sqrt(velocity_x[i] * velocity_x[i] +
+                                   velocity_y[i] * velocity_y[i]);
+
+    // Direction from zombie to player, or +x if they coincide. Adding the
+    // smallest normal float avoids dividing by zero without a branch and
+    // doesn't change any nonzero distance.
+    float dx = player_x - position_x;
+    float dy = player_y - position_y;
+    float distance_squared = dx * dx + dy * dy;
+    float inverse_distance =
+        1.f /
+        std::sqrt(distance_squared + std::numeric_limits<float>::min());
+    float zombie_cos = distance_squared > 0.f ? dx * inverse_distance : 1.f;
+    float zombie_sin = dy * inverse_distance;
+
+    // Follow the flow field if the player isn't in line of sight. Flow
+    // directions are unit vectors or zero.
+    float flow_length_squared = flow_x[i] * flow_x[i] + flow_y[i] * flow_y[i];
+    bool follow_flow = flow_length_squared > 0.f;
+    zombie_cos = follow_flow ? flow_x[i] : zombie_cos;
+    zombie_sin = follow_flow ? flow_y[i] : zombie_sin;
+
+    // Lead the target by rotating the aim by asin(k). Since sin(asin(k)) = k
+    // and cos(asin(k)) = √(1 − k²), no trigonometric functions are needed.
+    // Zombies following the flow don't lead.
+    float k = player_speed / zombie_speed *
+              (player_cos * zombie_cos - player_sin * zombie_sin);
+    k = follow_flow ? 0.f : k;
+    bool lead = std::abs(k) < 1.f;
+    float lead_sin = lead ? k : 0.f;
+    float lead_cos = lead ? std::sqrt(std::max(1.f - k * k, 0.f)) : 1.f;
+
+    float aim_x = zombie_speed * zombie_cos;
+    float aim_y = zombie_speed * zombie_sin;
+    float next_velocity_x = lead_cos * aim_x - lead_sin * aim_y;
+    float next_velocity_y = lead_sin * aim_x + lead_cos * aim_y;
+    velocity_x[i] = next_velocity_x;
+    velocity_y[i] = next_velocity_y;
+
+    // Only move if the zombie stays within the map. The bounds match
+    // sf::FloatRect::contains() on the map bounds inset by the radius.
+    float next_x = position_x + next_velocity_x * frame_duration[i];
+    float next_y = position_y + next_velocity_y * frame_duration[i];
+    float left = MAP_BOUNDS.position.x + radius[i];
+    float top = MAP_BOUNDS.position.y + radius[i];
+    float right = left + (MAP_BOUNDS.size.x - radius[i]);
+    float bottom = top + (MAP_BOUNDS.size.y - radius[i]);
+    bool inside = (next_x >= left) & (next_x < right) & (next_y >= top) &
+                  (next_y < bottom);
+    x[i] = inside ? next_x : position_x;
+    y[i] = inside ? next_y : position_y;
+  }
+}
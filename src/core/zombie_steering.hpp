@@ -0,0 +1,76 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include <SFML/System/Vector2.hpp>
+
+/// Pursuit terms that only depend on the player, computed once per frame.
+struct PursuitTarget {
+  /// Constructs a PursuitTarget.
+  ///
+  /// @param player_position Player position.
+  /// @param player_velocity Player velocity.
+  PursuitTarget(const sf::Vector2f& player_position,
+                const sf::Vector2f& player_velocity);
+
+  /// Player position.
+  sf::Vector2f player_position;
+
+  /// Player speed.
+  float player_speed;
+
+  /// Unit vector along the player's velocity, or zero if the player is still.
+  sf::Vector2f player_direction;
+};
+
+/// Zombie state gathered into structure-of-arrays layout for steering.
+///
+/// The arrays are members of one object, so the compiler can prove they don't
+/// overlap without runtime alias checks.
+struct SteeringChunk {
+  /// Maximum number of zombies per chunk.
+  static constexpr size_t CAPACITY = 512;
+
+  /// Number of zombies in the chunk.
+  size_t count = 0;
+
+  /// Zombie x positions.
+  std::array<float, CAPACITY> x;
+
+  /// Zombie y positions.
+  std::array<float, CAPACITY> y;
+
+  /// Zombie x velocities.
+  std::array<float, CAPACITY> velocity_x;
+
+  /// Zombie y velocities.
+  std::array<float, CAPACITY> velocity_y;
+
+  /// Zombie radii.
+  std::array<float, CAPACITY> radius;
+
+  /// Simulation time in seconds to move each zombie by.
+  std::array<float, CAPACITY> frame_duration;
+
+  /// Flow field x directions at the zombies, or zero to pursue the player
+  /// directly.
+  std::array<float, CAPACITY> flow_x;
+
+  /// Flow field y directions at the zombies, or zero to pursue the player
+  /// directly.
+  std::array<float, CAPACITY> flow_y;
+};
+
+/// Aims zombies at the player while leading the target, or along the flow
+/// field around obstacles, then moves them if they stay within the map.
+///
+/// The loop has no branches, so the compiler vectorizes it.
+///
+/// @param target Per-frame pursuit terms.
+/// @param chunk Zombies to steer. Positions and velocities are updated in
+///   place.
+void steer_zombies(const PursuitTarget& target, SteeringChunk& chunk);
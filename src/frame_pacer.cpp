@@ -0,0 +1,50 @@
+// Copyright (c) Tyler Veness
+
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <SFML/System/Sleep.hpp>
+
+FramePacer::FramePacer(int frame_rate) { set_frame_rate(frame_rate); }
+
+void FramePacer::set_frame_rate(int frame_rate) {
+  this->frame_rate = frame_rate;
+  if (frame_rate > 0) {
+    period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>{1.0 / frame_rate});
+  } else {
+    period = clock::duration::zero();
+  }
+  reset();
+}
+
+void FramePacer::wait() {
+  ++stats.frames;
+  if (frame_rate <= 0) {
+    return;
+  }
+
+  auto now = clock::now();
+  if (now > deadline) {
+    ++stats.missed;
+    stats.worst_lateness = std::max(
+        stats.worst_lateness,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline));
+  } else {
+    // sf::sleep() raises the OS timer resolution where the default is coarse
+    if (deadline - now > SPIN_DURATION) {
+      sf::sleep(std::chrono::duration_cast<std::chrono::microseconds>(
+          deadline - now - SPIN_DURATION));
+    }
+    while (clock::now() < deadline) {
+    }
+  }
+
+  deadline = std::max(deadline, now) + period;
+}
+
+void FramePacer::reset() {
+  deadline = clock::now() + period;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+
+/// Deadline counts of frame pacing.
+struct PacingStats {
+  /// Frames paced.
+  uint64_t frames = 0;
+
+  /// Frames that were ready after their deadline.
+  uint64_t missed = 0;
+
+  /// Longest time a frame was ready after its deadline.
+  std::chrono::nanoseconds worst_lateness{0};
+};
+
+/// Holds each frame until its target present time so frames are displayed at
+/// an even rate.
+///
+/// The window's built-in frame rate limit sleeps for the rest of the frame,
+/// but OS sleeps can overshoot by a millisecond or more, which shows up as
+/// jitter in frame times. The pacer sleeps until shortly before the deadline,
+/// then spins the rest of the way.
+///
+/// Deadlines follow a fixed schedule, so one slightly long sleep doesn't delay
+/// every frame after it. A frame that misses its deadline starts a new schedule
+/// from when it was ready instead of rushing later frames to catch up.
+class FramePacer {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  /// Constructs a FramePacer.
+  ///
+  /// @param frame_rate Target frame rate in Hz, or 0 for uncapped.
+  explicit FramePacer(int frame_rate);
+
+  /// Sets the target frame rate and starts a new schedule.
+  ///
+  /// @param frame_rate Target frame rate in Hz, or 0 for uncapped.
+  void set_frame_rate(int frame_rate);
+
+  /// Returns the target frame rate in Hz, or 0 if uncapped.
+  int get_frame_rate() const { return frame_rate; }
+
+  /// Waits until the current frame's deadline. Call it right before displaying
+  /// the frame.
+  void wait();
+
+  /// Starts a new schedule from now, like after a pause, without counting the
+  /// time since the last frame as a miss.
+  void reset();
+
+  /// Returns the deadline counts so far.
+  const PacingStats& get_stats() const { return stats; }
+
+ private:
+  /// Time before the deadline at which sleeping stops and spinning starts.
+  /// It covers how much OS sleeps typically overshoot.
+  static constexpr auto SPIN_DURATION = std::chrono::microseconds{1500};
+
+  int frame_rate;
+  clock::duration period{};
+
+  /// When the current frame should be displayed.
+  clock::time_point deadline;
+
+  PacingStats stats;
+};
@@ -0,0 +1,140 @@
+// Copyright (c) Tyler Veness
+
+#include "frame_recorder.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/Context.hpp>
+
+#include "trace.hpp"
+
+FrameRecorder::FrameRecorder(std::filesystem::path directory,
+                             CaptureFormat format, size_t num_textures)
+    : directory{std::move(directory)},
+      format{format},
+      textures(num_textures),
+      free_textures(num_textures) {
+  std::iota(free_textures.begin(), free_textures.end(), size_t{0});
+  writer = std::thread{&FrameRecorder::write_frames, this};
+}
+
+FrameRecorder::~FrameRecorder() {
+  if (writer.joinable()) {
+    stop();
+  }
+}
+
+void FrameRecorder::capture(const sf::RenderWindow& window) {
+  TRACE_SCOPE("capture");
+
+  uint64_t number = num_captured++;
+
+  size_t index;
+  {
+    std::scoped_lock lock{mutex};
+    ++stats.captured;
+    if (free_textures.empty()) {
+      ++stats.dropped;
+      return;
+    }
+    index = free_textures.back();
+    free_textures.pop_back();
+  }
+
+  // The texture isn't shared until it's queued
+  auto& texture = textures[index];
+  if (texture.getSize() != window.getSize() &&
+      !texture.resize(window.getSize())) {
+    std::scoped_lock lock{mutex};
+    free_textures.push_back(index);
+    ++stats.failed;
+    return;
+  }
+
+  // Copies on the GPU without waiting for the frame to finish rendering, then
+  // flushes so the writer thread's context sees the copy
+  texture.update(window);
+
+  {
+    std::scoped_lock lock{mutex};
+    queued_frames.push_back({number, index});
+  }
+  frame_queued_cv.notify_one();
+}
+
+void FrameRecorder::stop() {
+  {
+    std::scoped_lock lock{mutex};
+    stopping = true;
+  }
+  frame_queued_cv.notify_one();
+  writer.join();
+}
+
+CaptureStats FrameRecorder::get_stats() const {
+  std::scoped_lock lock{mutex};
+  return stats;
+}
+
+void FrameRecorder::write_frames() {
+  // Textures are shared between contexts, so the frames can be read back here
+  // instead of on the render thread
+  sf::Context context;
+
+  std::unique_lock lock{mutex};
+  while (true) {
+    frame_queued_cv.wait(
+        lock, [&] { return stopping || !queued_frames.empty(); });
+    if (queued_frames.empty()) {
+      return;
+    }
+
+    auto frame = queued_frames.front();
+    queued_frames.pop_front();
+
+    lock.unlock();
+    bool written = write_frame(frame);
+    lock.lock();
+
+    free_textures.push_back(frame.texture);
+    if (written) {
+      ++stats.written;
+    } else {
+      ++stats.failed;
+    }
+  }
+}
+
+bool FrameRecorder::write_frame(const QueuedFrame& frame) const {
+  TRACE_SCOPE("write frame");
+
+  // SFML can only read a texture back into a new image, so this allocates
+  // once per frame, but off the render thread
+  auto image = textures[frame.texture].copyToImage();
+
+  if (format == CaptureFormat::RAW) {
+    auto size = image.getSize();
+    std::ofstream file{directory / std::format("frame_{:06}.rgba",
+                                               frame.number),
+                       std::ios::binary};
+    file.write(reinterpret_cast<const char*>(image.getPixelsPtr()),
+               static_cast<std::streamsize>(size_t{size.x} * size.y * 4));
+    return file.good();
+  } else {
+    return image.saveToFile(
+        directory / std::format("frame_{:06}.png", frame.number));
+  }
+}
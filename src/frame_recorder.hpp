@@ -0,0 +1,139 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+/// File format of recorded frames.
+enum class CaptureFormat : uint8_t {
+  /// Unpadded 8-bit RGBA pixels, top row first.
+  RAW,
+
+  /// PNG images. Encoding them is much slower than writing raw frames.
+  PNG
+};
+
+/// Returns the capture format with the given name ("raw" or "png"), if any.
+///
+/// @param name The name.
+constexpr std::optional<CaptureFormat> capture_format_from_name(
+    std::string_view name) {
+  if (name == "raw") {
+    return CaptureFormat::RAW;
+  } else if (name == "png") {
+    return CaptureFormat::PNG;
+  } else {
+    return std::nullopt;
+  }
+}
+
+/// Frame counts of a recording.
+struct CaptureStats {
+  /// Frames passed to capture().
+  uint64_t captured = 0;
+
+  /// Frames written to disk.
+  uint64_t written = 0;
+
+  /// Frames dropped because every texture was waiting to be written.
+  uint64_t dropped = 0;
+
+  /// Frames that couldn't be written.
+  uint64_t failed = 0;
+};
+
+/// Records the window's frames to numbered files in a directory without
+/// stalling the render loop.
+///
+/// Each frame is copied into one of a fixed pool of textures on the GPU, which
+/// doesn't wait for the frame to finish rendering. A background thread with its
+/// own OpenGL context reads the textures back and writes them to disk, so the
+/// render thread never touches the pixels. If the disk falls behind and no
+/// texture is free, the frame is dropped and counted instead of blocking, so
+/// memory use is bounded by the pool size.
+class FrameRecorder {
+ public:
+  /// Starts a recording.
+  ///
+  /// @param directory Directory frames are written to. It must exist.
+  /// @param format File format.
+  /// @param num_textures Number of frame textures in the pool.
+  FrameRecorder(std::filesystem::path directory, CaptureFormat format,
+                size_t num_textures = 8);
+
+  /// Stops the recording if it's still going.
+  ~FrameRecorder();
+
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  /// Records the window's current contents. Call it after drawing a frame and
+  /// before displaying it.
+  ///
+  /// @param window The window.
+  void capture(const sf::RenderWindow& window);
+
+  /// Waits for queued frames to be written, then stops the recording.
+  /// capture() must not be called afterward.
+  void stop();
+
+  /// Returns the frame counts so far.
+  CaptureStats get_stats() const;
+
+  /// Returns the output directory.
+  const std::filesystem::path& get_directory() const { return directory; }
+
+ private:
+  /// A frame waiting to be written.
+  struct QueuedFrame {
+    /// Frame number, used in the file name.
+    uint64_t number;
+
+    /// Index of the texture holding the frame.
+    size_t texture;
+  };
+
+  std::filesystem::path directory;
+  CaptureFormat format;
+
+  /// Number of frames passed to capture(). Only used by the render thread.
+  uint64_t num_captured = 0;
+
+  mutable std::mutex mutex;
+  std::condition_variable frame_queued_cv;
+
+  /// Frame textures. A texture is only used by the render thread while it's
+  /// free and by the writer thread while it's queued.
+  std::vector<sf::Texture> textures;
+
+  /// Indices of textures not holding a queued frame.
+  std::vector<size_t> free_textures;
+
+  std::deque<QueuedFrame> queued_frames;
+  CaptureStats stats;
+  bool stopping = false;
+
+  std::thread writer;
+
+  /// Writes queued frames until stopped and the queue is empty.
+  void write_frames();
+
+  /// Reads a frame back from its texture and writes it to disk.
+  ///
+  /// @param frame The frame.
+  /// @return False if the frame couldn't be written.
+  bool write_frame(const QueuedFrame& frame) const;
+};
@@ -0,0 +1,270 @@
+// Copyright (c) Tyler Veness
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <print>
+#include <string_view>
+#include <thread>
+
+#include "allocation_tracker.hpp"
+#include "bot.hpp"
+#include "collision_stats.hpp"
+#include "frame_arena.hpp"
+#include "globals.hpp"
+#include "horde_config.hpp"
+#include "job_system.hpp"
+#include "parse_number.hpp"
+#include "process_memory.hpp"
+#include "profiler.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Headless run options.
+struct Options {
+  /// Run duration in seconds, or 0 to run until killed.
+  uint32_t duration = 0;
+
+  /// Seconds between report lines.
+  uint32_t report_interval = 10;
+
+  /// Random number seed, if any.
+  std::optional<uint64_t> seed;
+
+  /// Whether to step as fast as possible instead of at 60 Hz.
+  bool uncapped = false;
+
+  /// Number of threads for parallel updates and overlapping phases, if not the
+  /// defaults.
+  std::optional<uint32_t> threads;
+
+  /// Number of frames to record a trace for, or 0 to not record one.
+  uint32_t trace_frames = 0;
+
+  /// Seconds into the run at which trace recording starts.
+  uint32_t trace_start = 0;
+
+  /// File the trace is written to.
+  std::filesystem::path trace_file = "trace.json";
+
+  /// Seconds into the run after which heap allocations during simulation steps
+  /// abort the run, if any.
+  std::optional<uint32_t> forbid_allocations_after;
+
+  /// Zombie horde size limits.
+  HordeConfig horde_config;
+};
+
+/// Parses command-line arguments.
+///
+/// @param argc Argument count.
+/// @param argv Argument values.
+/// @param options The parsed options.
+/// @return True on success.
+bool parse_options(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    std::string_view value = i + 1 < argc ? argv[i + 1] : "";
+
+    if (arg == "--duration" && parse_number(value, options.duration)) {
+      ++i;
+    } else if (arg == "--report-interval" &&
+               parse_number(value, options.report_interval) &&
+               options.report_interval > 0) {
+      ++i;
+    } else if (uint64_t seed; arg == "--seed" && parse_number(value, seed)) {
+      options.seed = seed;
+      ++i;
+    } else if (arg == "--uncapped") {
+      options.uncapped = true;
+    } else if (uint32_t threads; arg == "--threads" &&
+                                 parse_number(value, threads) && threads > 0) {
+      options.threads = threads;
+      ++i;
+    } else if (arg == "--trace-frames" &&
+               parse_number(value, options.trace_frames)) {
+      ++i;
+    } else if (arg == "--trace-start" &&
+               parse_number(value, options.trace_start)) {
+      ++i;
+    } else if (arg == "--trace-file" && !value.empty()) {
+      options.trace_file = value;
+      ++i;
+    } else if (uint32_t start; arg == "--forbid-allocations-after" &&
+                               parse_number(value, start)) {
+      options.forbid_allocations_after = start;
+      ++i;
+    } else if (uint32_t cap; arg == "--horde-cap" &&
+                             parse_number(value, cap) && cap > 0) {
+      options.horde_config.max_zombies = cap;
+      ++i;
+    } else if (auto ramp = horde_ramp_from_name(value);
+               arg == "--horde-ramp" && ramp) {
+      options.horde_config.ramp = *ramp;
+      ++i;
+    } else if (uint32_t duration; arg == "--horde-ramp-duration" &&
+                                  parse_number(value, duration) &&
+                                  duration > 0) {
+      options.horde_config.ramp_duration = static_cast<float>(duration);
+      ++i;
+    } else if (uint32_t wave_size; arg == "--horde-wave-size" &&
+                                   parse_number(value, wave_size) &&
+                                   wave_size > 0) {
+      options.horde_config.wave_size = wave_size;
+      ++i;
+    } else {
+      std::println(stderr,
+                   "usage: {} [--duration <s>] [--report-interval <s>] "
+                   "[--seed <n>] [--uncapped] [--threads <n>] "
+                   "[--trace-frames <n>] [--trace-start <s>] "
+                   "[--trace-file <path>] [--forbid-allocations-after <s>] "
+                   "[--horde-cap <n>] "
+                   "[--horde-ramp experience|linear|quadratic|immediate] "
+                   "[--horde-ramp-duration <s>] [--horde-wave-size <n>]",
+                   argv[0]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  using clock = std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+  using milliseconds = std::chrono::duration<double, std::milli>;
+
+  Options options;
+  if (!parse_options(argc, argv, options)) {
+    return 1;
+  }
+
+  if (options.forbid_allocations_after && !AllocationTracker::ENABLED) {
+    std::println(stderr, "Allocation tracking is disabled in this build");
+    return 1;
+  }
+
+  if (options.seed) {
+    seed_global_random(*options.seed);
+  }
+
+  constexpr auto FRAME_PERIOD = std::chrono::microseconds{16'667};
+
+  World world;
+  world.set_horde_config(options.horde_config);
+  Bot bot;
+
+  std::optional<ThreadPool> thread_pool;
+  std::optional<JobSystem> job_system;
+  if (options.threads) {
+    thread_pool.emplace(static_cast<int>(*options.threads));
+    world.set_thread_pool(*thread_pool);
+    job_system.emplace(static_cast<int>(*options.threads));
+    world.set_job_system(*job_system);
+  }
+
+  uint32_t deaths = 0;
+
+  // Stats since the last report
+  uint64_t frames = 0;
+  seconds total_step_time{0.0};
+  seconds max_step_time{0.0};
+  AllocationCounts allocation_counts;
+
+  std::println(
+      "time_s,frames,mean_step_ms,max_step_ms,zombies,zombie_cap,bullets,"
+      "weapon_crates,xp,deaths,rss_bytes,allocs_per_frame,"
+      "alloc_bytes_per_frame,player_bytes,bullet_bytes,zombie_bytes,"
+      "weapon_crate_bytes");
+
+  auto start_time = clock::now();
+  auto last_frame_time = start_time;
+  auto last_report_time = start_time;
+
+  while (options.duration == 0 ||
+         seconds{clock::now() - start_time}.count() < options.duration) {
+    auto frame_start_time = clock::now();
+    float frame_duration =
+        seconds{frame_start_time - last_frame_time}.count();
+    last_frame_time = frame_start_time;
+    global_profiler().begin_frame(frame_duration);
+    global_allocation_tracker().begin_frame();
+    global_collision_stats().begin_frame();
+    allocation_counts += global_allocation_tracker().get_frame_counts();
+    global_tracer().begin_frame();
+    TRACE_SCOPE("frame");
+
+    if (options.trace_frames > 0 &&
+        seconds{frame_start_time - start_time}.count() >=
+            options.trace_start) {
+      if (!global_tracer().start(options.trace_file,
+                                 static_cast<int>(options.trace_frames))) {
+        std::println(stderr, "Tracing is disabled in this build");
+      }
+      options.trace_frames = 0;
+    }
+
+    // Steady state simulation steps shouldn't touch the heap
+    bool forbid_allocations =
+        options.forbid_allocations_after &&
+        seconds{frame_start_time - start_time}.count() >=
+            *options.forbid_allocations_after;
+    global_allocation_tracker().set_allocations_forbidden(forbid_allocations);
+    world.step(frame_duration, bot.update(world));
+    global_allocation_tracker().set_allocations_forbidden(false);
+
+    if (world.get_player().get_health() <= 0.f) {
+      ++deaths;
+      world.reset();
+    }
+
+    auto step_time = seconds{clock::now() - frame_start_time};
+    total_step_time += step_time;
+    max_step_time = std::max(max_step_time, step_time);
+    ++frames;
+
+    if (seconds{clock::now() - last_report_time}.count() >=
+        options.report_interval) {
+      auto footprint = world.get_memory_footprint();
+      std::println(
+          "{:.1f},{},{:.3f},{:.3f},{},{},{},{},{},{},{},{:.1f},{:.1f},{},{},{},"
+          "{}",
+          seconds{clock::now() - start_time}.count(), frames,
+          milliseconds{total_step_time}.count() / frames,
+          milliseconds{max_step_time}.count(), world.get_zombies().size(),
+          world.get_zombie_cap(), world.get_bullets().size(),
+          world.get_weapon_crates().size(), world.get_player().get_xp(), deaths,
+          resident_set_size(),
+          static_cast<double>(allocation_counts.allocations) / frames,
+          static_cast<double>(allocation_counts.allocated_bytes) / frames,
+          footprint.player, footprint.bullets, footprint.zombies,
+          footprint.weapon_crates);
+      fflush(stdout);
+
+      last_report_time = clock::now();
+      frames = 0;
+      total_step_time = seconds{0.0};
+      max_step_time = seconds{0.0};
+      allocation_counts = {};
+    }
+
+    global_frame_arena().reset();
+
+    if (!options.uncapped) {
+      std::this_thread::sleep_until(frame_start_time + FRAME_PERIOD);
+    }
+  }
+
+  global_collision_stats().begin_frame();
+  std::print(stderr, "Collision statistics:\n{}",
+             global_collision_stats().get_session_counts().to_string());
+}
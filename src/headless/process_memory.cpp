@@ -0,0 +1,46 @@
+// Copyright (c) Tyler Veness
+
+#include "process_memory.hpp"
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+// psapi.h must be included after windows.h
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <fstream>
+
+#include <unistd.h>
+#endif
+
+size_t resident_set_size() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.WorkingSetSize;
+  }
+  return 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+    return info.resident_size;
+  }
+  return 0;
+#elif defined(__linux__)
+  // Second field of statm is resident pages
+  std::ifstream statm{"/proc/self/statm"};
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,9 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+/// Returns the process's resident set size in bytes, or 0 if it's unavailable
+/// on this platform.
+size_t resident_set_size();
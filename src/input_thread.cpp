@@ -0,0 +1,56 @@
+// Copyright (c) Tyler Veness
+
+#include "input_thread.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include <SFML/Window/Mouse.hpp>
+
+InputThread::InputThread() : sampler{&InputThread::sample, this} {}
+
+InputThread::~InputThread() {
+  stopping.store(true, std::memory_order_relaxed);
+  sampler.join();
+}
+
+FireInput InputThread::consume_fire(clock::time_point step_start_time,
+                                    clock::time_point step_end_time) {
+  FireInput input;
+  bool held_at_start = fire_held;
+
+  while (auto event = fire_events.front()) {
+    // Later changes belong to the next step
+    if (event->time > step_end_time) {
+      break;
+    }
+
+    if (event->time < step_start_time) {
+      held_at_start = event->pressed;
+    } else if (event->pressed && !input.press_time) {
+      input.press_time = event->time;
+    }
+    fire_held = event->pressed;
+    fire_events.pop();
+  }
+
+  input.fire = held_at_start || input.press_time || fire_held;
+  return input;
+}
+
+void InputThread::sample() {
+  bool pressed = false;
+  auto next_sample_time = clock::now();
+
+  while (!stopping.load(std::memory_order_relaxed)) {
+    bool now_pressed = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
+    if (now_pressed != pressed &&
+        fire_events.push({clock::now(), now_pressed})) {
+      pressed = now_pressed;
+    }
+
+    // Sleeping to a schedule keeps samples evenly spaced
+    next_sample_time += SAMPLE_PERIOD;
+    std::this_thread::sleep_until(next_sample_time);
+  }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "spsc_queue.hpp"
+
+/// Fire button state over a simulation step.
+struct FireInput {
+  /// Whether the button was held at any point during the step.
+  bool fire = false;
+
+  /// When the button was pressed, if it was pressed during the step.
+  std::optional<std::chrono::steady_clock::time_point> press_time;
+};
+
+/// Samples the fire button on its own thread and timestamps its presses and
+/// releases.
+///
+/// The main loop only looks at input once per frame, so without this a click
+/// waits up to a frame before the simulation sees it, and the shot comes out
+/// at the start of the next step no matter when the click happened. Timestamps
+/// let the step fire at the moment of the click instead, and quick clicks
+/// released before the frame ends still count.
+///
+/// SFML only delivers window events to the thread that owns the window, so
+/// the thread polls the button's real-time state instead.
+class InputThread {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  /// Starts sampling.
+  InputThread();
+
+  /// Stops sampling.
+  ~InputThread();
+
+  InputThread(const InputThread&) = delete;
+  InputThread& operator=(const InputThread&) = delete;
+
+  /// Consumes the fire button changes up to the end of a simulation step.
+  /// Changes before the step's start, like clicks in a menu, only update
+  /// whether the button is held.
+  ///
+  /// @param step_start_time Start of the step.
+  /// @param step_end_time End of the step.
+  FireInput consume_fire(clock::time_point step_start_time,
+                         clock::time_point step_end_time);
+
+ private:
+  /// Time between samples.
+  static constexpr auto SAMPLE_PERIOD = std::chrono::milliseconds{1};
+
+  /// Fire button change.
+  struct FireEvent {
+    clock::time_point time;
+    bool pressed;
+  };
+
+  /// Changes not consumed yet. If the main loop stalls long enough to fill
+  /// it, further changes are dropped.
+  SpscQueue<FireEvent, 256> fire_events;
+
+  /// Whether the button is held as of the last consumed change.
+  bool fire_held = false;
+
+  std::atomic<bool> stopping = false;
+  std::thread sampler;
+
+  /// Samples input until stopped.
+  void sample();
+};
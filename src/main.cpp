@@ -1,345 +1,391 @@
 // Copyright (c) Tyler Veness
 
-#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <print>
+#include <string_view>
+#include <system_error>
 
-#include <cmath>
-#include <deque>
-#include <memory>
-#include <utility>
-#include <vector>
-
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/ConvexShape.hpp>
 #include <SFML/Graphics/Rect.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
-#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
 #include <SFML/System/Clock.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 
-#include "bullet.hpp"
-#include "collision_detector.hpp"
+#include "allocation_tracker.hpp"
+#include "bot.hpp"
+#include "collision_stats.hpp"
+#include "colors.hpp"
 #include "constants.hpp"
+#include "frame_arena.hpp"
+#include "frame_pacer.hpp"
+#include "frame_recorder.hpp"
+#include "input_thread.hpp"
 #include "menus.hpp"
-#include "player.hpp"
-#include "weapon.hpp"
-#include "weapon_crate.hpp"
-#include "weapon_type.hpp"
-#include "zombie.hpp"
-
-int main() {
-  sf::RenderWindow main_window{sf::VideoMode{sf::Vector2u{SCREEN_DIMS}},
-                               "Abstract Art Revival", sf::Style::Default,
-                               sf::State::Fullscreen};
-  main_window.setFramerateLimit(60);
-
-  sf::View view;
-  view.setViewport(sf::FloatRect{{0.f, 0.f}, {1.f, 1.f}});
-  view.setCenter(SCREEN_DIMS / 2.f);
-  main_window.setView(view);
-
-  display_main_menu(main_window, SCREEN_DIMS / 2.f);
-
-  sf::Clock frame_clock;
+#include "parse_number.hpp"
+#include "performance_overlay.hpp"
+#include "profiler.hpp"
+#include "renderer.hpp"
+#include "snapshot.hpp"
+#include "snapshot_history.hpp"
+#include "startup.hpp"
+#include "trace.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Number of frames recorded per trace capture.
+constexpr int TRACE_FRAMES = 300;
+
+/// Number of frames that can be rewound, about five seconds at 60 FPS.
+constexpr size_t REWIND_FRAMES = 300;
+
+/// Frame rates F6 cycles through in Hz. 0 is uncapped.
+constexpr std::array FRAME_RATES{60, 120, 144, 0};
+
+/// Frame rate menus are limited to in Hz.
+constexpr unsigned int MENU_FRAME_RATE = 60;
+
+/// Limits the window's frame rate while a menu is shown, then hands pacing
+/// back to the frame pacer. Menus are static, so the window's coarse limit is
+/// precise enough for them.
+class ScopedMenuFrameLimit {
+ public:
+  /// Limits the window's frame rate.
+  ///
+  /// @param window The window.
+  /// @param frame_pacer Frame pacer to restart when the menu closes.
+  ScopedMenuFrameLimit(sf::RenderWindow& window, FramePacer& frame_pacer)
+      : window{window}, frame_pacer{frame_pacer} {
+    window.setFramerateLimit(MENU_FRAME_RATE);
+  }
 
-  std::deque<Bullet> bullets;
-  std::vector<WeaponCrate> weapon_crates;
-  Player player{SCREEN_DIMS / 2.f};
-  std::vector<Zombie> zombies;
+  /// Removes the limit and restarts the frame pacer.
+  ~ScopedMenuFrameLimit() {
+    window.setFramerateLimit(0);
+    frame_pacer.reset();
+  }
 
-  // Make ground tile
-  sf::RenderTexture ground_render_texture{{20, 20}};
-  ground_render_texture.setRepeated(true);
-  {
-    ground_render_texture.clear(GROUND_COLOR);
+  ScopedMenuFrameLimit(const ScopedMenuFrameLimit&) = delete;
+  ScopedMenuFrameLimit& operator=(const ScopedMenuFrameLimit&) = delete;
+
+ private:
+  sf::RenderWindow& window;
+  FramePacer& frame_pacer;
+};
+
+/// Parses a frame rate in Hz from a command-line argument.
+///
+/// @param arg The argument.
+/// @param frame_rate The parsed frame rate.
+/// @return True on success.
+bool parse_frame_rate(std::string_view arg, int& frame_rate) {
+  return parse_number(arg, frame_rate) && frame_rate >= 0;
+}
 
-    sf::RectangleShape rect{{2.f, 2.f}};
-    rect.setFillColor(sf::Color{60, 60, 60});
+/// Switches to the next frame rate in FRAME_RATES.
+///
+/// @param frame_pacer The frame pacer.
+void cycle_frame_rate(FramePacer& frame_pacer) {
+  auto it = std::ranges::find(FRAME_RATES, frame_pacer.get_frame_rate());
+  if (it == FRAME_RATES.end() || ++it == FRAME_RATES.end()) {
+    it = FRAME_RATES.begin();
+  }
+  frame_pacer.set_frame_rate(*it);
 
-    rect.setPosition({2.f, 3.f});
-    ground_render_texture.draw(rect);
+  if (*it > 0) {
+    std::println("Frame rate: {} Hz", *it);
+  } else {
+    std::println("Frame rate: uncapped");
+  }
+}
 
-    rect.setPosition({8.f, 13.f});
-    ground_render_texture.draw(rect);
+/// Starts a recording into a new timestamped directory, or stops the current
+/// one and prints its frame counts.
+///
+/// @param recorder The current recording, if any.
+/// @param format File format of new recordings.
+void toggle_recording(std::optional<FrameRecorder>& recorder,
+                      CaptureFormat format) {
+  if (!recorder) {
+    auto directory = std::format(
+        "capture_{:%Y%m%d_%H%M%S}",
+        std::chrono::floor<std::chrono::seconds>(
+            std::chrono::system_clock::now()));
+
+    // Failing to record shouldn't end the game, so report errors instead of
+    // throwing
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+      std::println(stderr, "Couldn't create {}: {}", directory,
+                   error.message());
+      return;
+    }
 
-    rect.setPosition({15.f, 6.f});
-    ground_render_texture.draw(rect);
+    recorder.emplace(directory, format);
+    std::println("Recording to {}", directory);
+    return;
+  }
 
-    rect.setPosition({18.f, 16.f});
-    ground_render_texture.draw(rect);
+  recorder->stop();
+  auto stats = recorder->get_stats();
+  std::println(
+      "Recorded {} frames to {} ({} written, {} dropped, {} failed)",
+      stats.captured, recorder->get_directory().string(), stats.written,
+      stats.dropped, stats.failed);
+  recorder.reset();
+}
 
-    ground_render_texture.display();
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // Let the autoplay bot drive the player if requested
+  bool autoplay = false;
+  auto capture_format = CaptureFormat::RAW;
+  int frame_rate = FRAME_RATES[0];
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--bot") {
+      autoplay = true;
+    } else if (auto format = capture_format_from_name(
+                   i + 1 < argc ? argv[i + 1] : "");
+               arg == "--capture-format" && format) {
+      capture_format = *format;
+      ++i;
+    } else if (arg == "--frame-rate" && i + 1 < argc &&
+               parse_frame_rate(argv[i + 1], frame_rate)) {
+      ++i;
+    } else {
+      std::println(stderr,
+                   "usage: {} [--bot] [--capture-format raw|png] "
+                   "[--frame-rate HZ]",
+                   argv[0]);
+      return 1;
+    }
   }
 
-  // Make ground sprite as repeating ground tile
-  sf::Sprite ground_sprite{ground_render_texture.getTexture(),
-                           {{0, 0}, sf::Vector2i{MAP_BOUNDS.size}}};
+  // Assets load while the window is created and the main menu is shown
+  AssetPreloader preloader;
 
-  while (main_window.isOpen()) {
-    float frame_duration = frame_clock.restart().asSeconds();
+  sf::RenderWindow main_window{sf::VideoMode{sf::Vector2u{SCREEN_DIMS}},
+                               "Abstract Art Revival", sf::Style::Default,
+                               sf::State::Fullscreen};
+  main_window.setFramerateLimit(MENU_FRAME_RATE);
+  log_startup_phase("window created");
+
+  sf::View view;
+  view.setViewport(sf::FloatRect{{0.f, 0.f}, {1.f, 1.f}});
+  view.setCenter(SCREEN_DIMS / 2.f);
+  main_window.setView(view);
 
+  // Keep the window responsive until the menu's font is ready
+  while (main_window.isOpen() && !preloader.is_font_ready()) {
     while (auto event = main_window.pollEvent()) {
       if (event->is<sf::Event::Closed>()) {
         main_window.close();
-      } else if (auto key_event = event->getIf<sf::Event::KeyPressed>()) {
-        if (key_event->code == sf::Keyboard::Key::Q) {
-          player.switch_to_previous_weapon();
-        } else if (key_event->code == sf::Keyboard::Key::E) {
-          player.switch_to_next_weapon();
-        }
-      }
-    }
-
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left) &&
-        player.try_fire()) {
-      auto angle =
-          main_window.mapPixelToCoords(sf::Mouse::getPosition(main_window)) -
-          player.get_position();
-      if (angle.x != 0.f || angle.y != 0.f) {
-        angle /= angle.length();
-      }
-
-      if (player.get_current_weapon().ammo > 0) {
-        if (player.get_current_weapon().type == WeaponType::SHOTGUN) {
-          for (int i = 0; i < 15; ++i) {
-            bullets.emplace_back(player.get_current_weapon().make_bullet(
-                player.get_position(), angle));
-          }
-        } else {
-          bullets.emplace_back(player.get_current_weapon().make_bullet(
-              player.get_position(), angle));
-        }
-
-        --player.get_current_weapon().ammo;
       }
     }
 
-    // Update movement for all moving entities
-    for (auto& bullet : bullets) {
-      bullet.update_movement(frame_duration);
-    }
-
-    sf::Vector2f player_direction;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
-      player_direction.y -= 1.f;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
-      player_direction.y += 1.f;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
-      player_direction.x -= 1.f;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
-      player_direction.x += 1.f;
-    }
-    if (player_direction.x != 0.f || player_direction.y != 0.f) {
-      player_direction /= player_direction.length();
-    }
-    player.update_movement(
-        frame_duration, player_direction,
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space));
-
-    for (auto& zombie : zombies) {
-      zombie.update_movement(frame_duration, player.get_position(),
-                             player.get_velocity());
-    }
+    main_window.clear(BACKGROUND_COLOR);
+    main_window.display();
+  }
 
-    view.setCenter(player.get_position());
-    main_window.setView(view);
+  log_startup_phase("main menu shown");
+  display_main_menu(main_window, SCREEN_DIMS / 2.f);
 
-    WeaponCrate::spawn(weapon_crates, player);
-    Zombie::spawn(zombies, player.get_xp());
+  preloader.wait();
+  Renderer renderer;
+  PerformanceOverlay performance_overlay;
+  log_startup_phase("game started");
 
-    // Check for bullet -> zombie collisions
-    for (size_t i = 0; i < bullets.size(); ++i) {
-      // Index is used here instead of iterator since insertion can invalidate
-      // all iterators
-      auto& bullet = bullets[i];
+  // The frame pacer takes over from the window's limit once the game starts
+  main_window.setFramerateLimit(0);
+  FramePacer frame_pacer{frame_rate};
 
-      for (auto it = zombies.begin(); it != zombies.end();) {
-        auto& zombie = *it;
+  InputThread input_thread;
+  auto frame_start_time = std::chrono::steady_clock::now();
 
-        // If bounding boxes don't intersect, skip more expensive
-        // collision check
-        if (!zombie.get_global_bounds().findIntersection(
-                bullet.get_global_bounds())) {
-          ++it;
-          continue;
-        }
+  World world;
+  Bot bot;
+  std::optional<FrameRecorder> recorder;
 
-        CollisionDetector detector;
-        detector.add_circle(zombie.get_position(), zombie.get_radius());
-        if (bullet.get_shape() == BulletShape::CIRCLE) {
-          detector.add_circle(bullet.get_position(),
-                              bullet.get_global_bounds().size.x);
-        } else if (bullet.get_shape() == BulletShape::RECTANGLE) {
-          detector.add_rectangle(bullet.get_position(),
-                                 bullet.get_global_bounds().size,
-                                 bullet.get_rotation());
-        } else if (bullet.get_shape() == BulletShape::CONVEX) {
-          detector.add_rectangle(bullet.get_position(),
-                                 bullet.get_global_bounds().size,
-                                 bullet.get_rotation());
-        }
+  // New games restart from here instead of rebuilding the world
+  Snapshot new_game;
+  world.save(new_game);
+  SnapshotHistory history{REWIND_FRAMES};
 
-        if (detector.collides()) {
-          zombie.decrement_health(bullet.get_damage());
-          if (zombie.get_health() <= 0.f) {
-            player.increment_xp(zombie.get_xp());
-            it = zombies.erase(it);
-
-            if (bullet.get_type() == WeaponType::LASER) {
-              // If zombie dies to laser, spawn five more lower-damage ones
-              for (int i = 0; i < 5; ++i) {
-                auto body_shape = std::make_unique<sf::RectangleShape>(
-                    sf::Vector2f{20.f, 2.f});
-                body_shape->setFillColor(sf::Color::White);
-                bullets.emplace_back(
-                    bullet.get_position(),
-                    bullet.get_velocity().rotatedBy(random_angle(0.f)),
-                    WeaponType::LASER, bullet.get_damage() / 10,
-                    std::move(body_shape), BulletShape::RECTANGLE);
-              }
-            } else if (bullet.get_type() == WeaponType::ROCKET_LAUNCHER) {
-              // If zombie dies to rocket launcher, deal area damage
-              for (auto& area_zombie : zombies) {
-                if (std::hypot(
-                        area_zombie.get_position().x - bullet.get_position().x,
-                        area_zombie.get_position().y -
-                            bullet.get_position().y) < 120.f) {
-                  area_zombie.decrement_health(bullet.get_damage());
-                }
-              }
-
-              // Draw explosion radius
-              auto body_shape = std::make_unique<sf::CircleShape>(60.f);
-              body_shape->setFillColor(sf::Color::Yellow);
-              body_shape->setOutlineThickness(36.f);
-              body_shape->setOutlineColor(sf::Color::Red);
-              bullets.emplace_back(
-                  bullet.get_position(), sf::Vector2f{0.f, 0.f},
-                  WeaponType::FLAMETHROWER, bullet.get_damage(),
-                  std::move(body_shape), BulletShape::CIRCLE);
-            }
+  while (main_window.isOpen()) {
+    auto last_frame_start_time = frame_start_time;
+    frame_start_time = std::chrono::steady_clock::now();
+    float frame_duration = std::chrono::duration<float>{
+        frame_start_time - last_frame_start_time}
+                               .count();
+    global_profiler().begin_frame(frame_duration);
+    global_allocation_tracker().begin_frame();
+    global_collision_stats().begin_frame();
+    global_tracer().begin_frame();
+    TRACE_SCOPE("frame");
+
+    auto& player = world.get_player();
+
+    PlayerInput input;
+    std::optional<std::chrono::steady_clock::time_point> fire_press_time;
+    {
+      ScopedPhaseTimer timer{Phase::INPUT};
+
+      while (auto event = main_window.pollEvent()) {
+        if (event->is<sf::Event::Closed>()) {
+          main_window.close();
+        } else if (auto key_event = event->getIf<sf::Event::KeyPressed>()) {
+          if (key_event->code == sf::Keyboard::Key::Q) {
+            player.switch_to_previous_weapon();
+          } else if (key_event->code == sf::Keyboard::Key::E) {
+            player.switch_to_next_weapon();
+          } else if (key_event->code == sf::Keyboard::Key::F3) {
+            performance_overlay.toggle();
+          } else if (key_event->code == sf::Keyboard::Key::F4) {
+            global_tracer().start("trace.json", TRACE_FRAMES);
+          } else if (key_event->code == sf::Keyboard::Key::F5) {
+            toggle_recording(recorder, capture_format);
+          } else if (key_event->code == sf::Keyboard::Key::F6) {
+            cycle_frame_rate(frame_pacer);
           }
-
-          bullets.erase(bullets.begin() + i);
-          break;
         }
-
-        ++it;
       }
 
-      if (!MAP_BOUNDS.contains(bullet.get_position()) || bullet.expired()) {
-        bullets.erase(bullets.begin() + i);
+      // The step simulates the time since the last frame started, so presses
+      // during it fire partway through the step
+      auto fire_input =
+          input_thread.consume_fire(last_frame_start_time, frame_start_time);
+      input.fire = fire_input.fire;
+      if (fire_input.press_time) {
+        fire_press_time = fire_input.press_time;
+        input.fire_delay = std::chrono::duration<float>{
+            *fire_input.press_time - last_frame_start_time}
+                               .count();
       }
-    }
-
-    // Remove zombies killed by collateral damage
-    std::erase_if(zombies, [&](const auto& zombie) -> bool {
-      if (zombie.get_health() <= 0.f) {
-        player.increment_xp(zombie.get_xp());
-        return true;
-      } else {
-        return false;
+      input.aim_target =
+          main_window.mapPixelToCoords(sf::Mouse::getPosition(main_window));
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up) ||
+          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+        input.direction.y -= 1.f;
       }
-    });
-
-    // Check for player -> weapon crate collisions
-    for (auto it = weapon_crates.begin(); it != weapon_crates.end();) {
-      auto& crate = *it;
-
-      // If bounding boxes don't intersect, skip more expensive
-      // collision check
-      if (!player.get_global_bounds().findIntersection(
-              crate.get_global_bounds())) {
-        ++it;
-        continue;
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down) ||
+          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+        input.direction.y += 1.f;
       }
-
-      CollisionDetector detector;
-      detector.add_circle(player.get_position(), player.get_radius());
-      detector.add_rectangle(crate.get_position(), crate.get_size(),
-                             sf::radians(0.f));
-
-      // If player collided with weapon crate, pick it up
-      if (detector.collides()) {
-        player.get_weapon(crate.get_type()).ammo += crate.get_ammo();
-        player.switch_weapon(crate.get_type());
-
-        it = weapon_crates.erase(it);
-        continue;
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) ||
+          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+        input.direction.x -= 1.f;
       }
-
-      // If crate is too old, despawn it
-      if (crate.expired()) {
-        it = weapon_crates.erase(it);
-        continue;
+      if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) ||
+          sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+        input.direction.x += 1.f;
       }
+      input.sprint = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space);
 
-      ++it;
+      if (autoplay) {
+        input = bot.update(world);
+        fire_press_time.reset();
+      }
     }
 
-    // Check for zombie -> player collisions
-    for (auto& zombie : zombies) {
-      // If zombie intersects player, inflict damage to player
-      if (std::hypot(zombie.get_position().x - player.get_position().x,
-                     zombie.get_position().y - player.get_position().y) <
-          player.get_radius() + zombie.get_radius()) {
-        player.decrement_health(100.f * frame_duration);
-      }
+    // Holding backspace rewinds one frame at a time instead of stepping
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Backspace)) {
+      history.rewind(world, 1);
+    } else {
+      world.step(frame_duration, input);
+      history.record(world);
     }
 
+    view.setCenter(player.get_position());
+    main_window.setView(view);
+
     // Show pause menu or game over screen if applicable
     bool reset_game = false;
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Escape)) {
+      ScopedMenuFrameLimit menu_frame_limit{main_window, frame_pacer};
       if (display_pause_menu(main_window, player.get_position())) {
         reset_game = true;
       }
+
+      // Time spent in the menu doesn't advance the simulation
+      frame_start_time = std::chrono::steady_clock::now();
     }
     if (player.get_health() <= 0.f) {
+      ScopedMenuFrameLimit menu_frame_limit{main_window, frame_pacer};
       game_over(main_window, player.get_xp(), player.get_position());
       display_main_menu(main_window, player.get_position());
       reset_game = true;
+      frame_start_time = std::chrono::steady_clock::now();
     }
 
     if (reset_game) {
+      sf::Clock reset_clock;
       view.setCenter(SCREEN_DIMS / 2.f);
       main_window.setView(view);
-      Zombie::reset();
-      WeaponCrate::reset();
-      zombies.clear();
-      bullets.clear();
-      weapon_crates.clear();
+      world.restore(new_game, false);
+      history.clear();
 
-      player = Player{SCREEN_DIMS / 2.f};
+      float reset_time = reset_clock.getElapsedTime().asSeconds();
+      performance_overlay.set_reset_time(reset_time);
+      std::println("Game reset in {:.3f} ms", 1000.f * reset_time);
     }
 
     main_window.clear(BACKGROUND_COLOR);
-
-    main_window.draw(ground_sprite);
-
-    for (auto& weapon_crate : weapon_crates) {
-      weapon_crate.draw(main_window);
+    renderer.draw(main_window, world);
+    performance_overlay.draw(main_window, global_profiler(),
+                             global_allocation_tracker(),
+                             global_collision_stats(), world,
+                             renderer.get_draw_calls(), frame_pacer);
+
+    if (recorder) {
+      ScopedPhaseTimer timer{Phase::CAPTURE};
+      recorder->capture(main_window);
     }
 
-    for (auto& zombie : zombies) {
-      zombie.draw(main_window);
+    {
+      ScopedPhaseTimer timer{Phase::PACE};
+      frame_pacer.wait();
     }
 
-    player.draw(main_window);
+    {
+      ScopedPhaseTimer timer{Phase::DISPLAY};
+      main_window.display();
+    }
 
-    for (auto& bullet : bullets) {
-      bullet.draw(main_window);
+    if (fire_press_time) {
+      performance_overlay.add_input_latency(std::chrono::duration<float>{
+          std::chrono::steady_clock::now() - *fire_press_time}
+                                                .count());
     }
 
-    main_window.display();
+    global_frame_arena().reset();
   }
+
+  if (recorder) {
+    toggle_recording(recorder, capture_format);
+  }
+
+  const auto& pacing_stats = frame_pacer.get_stats();
+  std::println(
+      "Frame pacing: {} of {} frames missed their deadline (worst {:.2f} ms "
+      "late)",
+      pacing_stats.missed, pacing_stats.frames,
+      std::chrono::duration<double, std::milli>{pacing_stats.worst_lateness}
+          .count());
+
+  global_collision_stats().begin_frame();
+  std::print("Collision statistics:\n{}",
+             global_collision_stats().get_session_counts().to_string());
 }
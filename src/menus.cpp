@@ -12,8 +12,8 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Text.hpp>
 
-#include "constants.hpp"
-#include "globals.hpp"
+#include "colors.hpp"
+#include "resources.hpp"
 
 void load_high_scores(std::vector<unsigned int>& high_score_list) {
   std::ifstream load_file{"scores.txt"};
@@ -0,0 +1,179 @@
+// Copyright (c) Tyler Veness
+
+#include "performance_overlay.hpp"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "allocation_tracker.hpp"
+#include "collision_stats.hpp"
+#include "frame_pacer.hpp"
+#include "frame_arena.hpp"
+#include "profiler.hpp"
+#include "resources.hpp"
+#include "world.hpp"
+
+namespace {
+
+constexpr sf::Vector2f OVERLAY_POSITION{10.f, 10.f};
+constexpr sf::Vector2f OVERLAY_SIZE{320.f, 565.f};
+constexpr float GRAPH_HEIGHT = 100.f;
+
+/// Frame duration the graph compares against in milliseconds when the frame
+/// rate is uncapped.
+constexpr float UNCAPPED_REFERENCE_FRAME_MS = 1000.f / 60.f;
+
+}  // namespace
+
+PerformanceOverlay::PerformanceOverlay() : text{global_font(), "", 12} {
+  background.setPosition(OVERLAY_POSITION);
+  background.setSize(OVERLAY_SIZE);
+  background.setFillColor(sf::Color{0, 0, 0, 180});
+
+  text.setPosition(OVERLAY_POSITION +
+                   sf::Vector2f{5.f, GRAPH_HEIGHT + 10.f});
+}
+
+void PerformanceOverlay::add_input_latency(float latency) {
+  last_input_latency = latency;
+  total_input_latency += latency;
+  ++num_input_latencies;
+}
+
+void PerformanceOverlay::draw(sf::RenderTarget& target,
+                              const Profiler& profiler,
+                              const AllocationTracker& allocation_tracker,
+                              const CollisionStats& collision_stats,
+                              const World& world, int draw_calls,
+                              const FramePacer& frame_pacer) {
+  if (!visible) {
+    return;
+  }
+
+  ScopedPhaseTimer timer{Phase::DRAW_OVERLAY};
+
+  // Draw in screen space
+  auto world_view = target.getView();
+  target.setView(target.getDefaultView());
+
+  target.draw(background);
+
+  float target_frame_ms = frame_pacer.get_frame_rate() > 0
+                              ? 1000.f / frame_pacer.get_frame_rate()
+                              : UNCAPPED_REFERENCE_FRAME_MS;
+
+  // Build rolling frame time graph, oldest frame on the left
+  const auto& frame_durations = profiler.get_frame_durations();
+  float graph_bottom = OVERLAY_POSITION.y + 5.f + GRAPH_HEIGHT;
+  graph.clear();
+  for (size_t i = 0; i < frame_durations.size(); ++i) {
+    float frame_ms =
+        1000.f * frame_durations[(profiler.get_oldest_frame_index() + i) %
+                                 frame_durations.size()];
+    float x = OVERLAY_POSITION.x + 5.f + static_cast<float>(i);
+    float height = std::min(frame_ms * PIXELS_PER_MS, GRAPH_HEIGHT);
+    sf::Color color =
+        frame_ms > target_frame_ms * 1.25f ? sf::Color::Red : sf::Color::Green;
+
+    graph.append(sf::Vertex{{x, graph_bottom}, color, {}});
+    graph.append(sf::Vertex{{x, graph_bottom - height}, color, {}});
+  }
+
+  // Target frame duration reference line
+  float target_y = graph_bottom - target_frame_ms * PIXELS_PER_MS;
+  float graph_right =
+      OVERLAY_POSITION.x + 5.f + static_cast<float>(frame_durations.size());
+  graph.append(sf::Vertex{
+      {OVERLAY_POSITION.x + 5.f, target_y}, sf::Color::White, {}});
+  graph.append(sf::Vertex{{graph_right, target_y}, sf::Color::White, {}});
+  target.draw(graph);
+
+  // Build per-phase timings and counts
+  std::pmr::string str{&global_frame_arena()};
+  std::format_to(
+      std::back_inserter(str), "frame: {:.2f} ms (line = {:.1f} ms)\n",
+      1000.f * frame_durations[(profiler.get_oldest_frame_index() +
+                                frame_durations.size() - 1) %
+                               frame_durations.size()],
+      target_frame_ms);
+  for (int i = 0; i < NUM_PHASES; ++i) {
+    auto phase = static_cast<Phase>(i);
+    std::format_to(std::back_inserter(str), "{}: {:.3f} ms (avg {:.3f})",
+                   phase_name(phase), profiler.get_phase_time(phase),
+                   profiler.get_average_phase_time(phase));
+    if constexpr (AllocationTracker::ENABLED) {
+      std::format_to(std::back_inserter(str), " {} allocs",
+                     allocation_tracker.get_phase_counts(phase).allocations);
+    }
+    str += '\n';
+  }
+  if constexpr (AllocationTracker::ENABLED) {
+    auto counts = allocation_tracker.get_frame_counts();
+    std::format_to(std::back_inserter(str),
+                   "allocs: {}  frees: {}  bytes: +{} -{}\n",
+                   counts.allocations, counts.frees, counts.allocated_bytes,
+                   counts.freed_bytes);
+  }
+  const auto& collision_counts = collision_stats.get_frame_counts();
+  std::format_to(std::back_inserter(str),
+                 "pairs: {}  AABB rejects: {}  narrowphase: {}\n"
+                 "solver iters: {}  fails: {}  hits: {}  kills: {}\n",
+                 collision_counts.candidate_pairs,
+                 collision_counts.aabb_rejects,
+                 collision_counts.get_narrowphase_tests(),
+                 collision_counts.solver_iterations,
+                 collision_counts.solver_failures, collision_counts.hits,
+                 collision_counts.kills);
+  auto footprint = world.get_memory_footprint();
+  std::format_to(std::back_inserter(str),
+                 "bullets: {}  zombies: {}  crates: {}  draw calls: {}\n"
+                 "memory: player {} B  bullets {} B  zombies {} B  crates {} B",
+                 world.get_bullets().size(), world.get_zombies().size(),
+                 world.get_weapon_crates().size(), draw_calls,
+                 footprint.player, footprint.bullets, footprint.zombies,
+                 footprint.weapon_crates);
+  const auto& resource_cache = global_resource_cache();
+  std::format_to(std::back_inserter(str),
+                 "\nresources: {} loaded in {:.1f} ms",
+                 resource_cache.get_size(),
+                 1000.0 * resource_cache.get_load_time().count());
+  if (reset_time) {
+    std::format_to(std::back_inserter(str), "  last reset: {:.3f} ms",
+                   1000.f * *reset_time);
+  }
+  if (num_input_latencies > 0) {
+    std::format_to(std::back_inserter(str),
+                   "\ninput latency: {:.1f} ms  avg {:.1f} ms",
+                   1000.f * last_input_latency,
+                   1000.f * total_input_latency / num_input_latencies);
+  }
+  const auto& pacing_stats = frame_pacer.get_stats();
+  if (frame_pacer.get_frame_rate() > 0) {
+    std::format_to(std::back_inserter(str), "\npacing: {} Hz",
+                   frame_pacer.get_frame_rate());
+  } else {
+    std::format_to(std::back_inserter(str), "\npacing: uncapped");
+  }
+  std::format_to(
+      std::back_inserter(str), "  missed {}/{} (worst {:.2f} ms late)",
+      pacing_stats.missed, pacing_stats.frames,
+      std::chrono::duration<double, std::milli>{pacing_stats.worst_lateness}
+          .count());
+  text.setString(str.c_str());
+  target.draw(text);
+
+  target.setView(world_view);
+}
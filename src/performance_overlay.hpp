@@ -0,0 +1,79 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <optional>
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include "allocation_tracker.hpp"
+#include "collision_stats.hpp"
+#include "frame_pacer.hpp"
+#include "profiler.hpp"
+#include "world.hpp"
+
+/// Toggleable overlay showing a rolling frame time graph, per-phase timings and
+/// allocations, collision counters, entity counts, entity memory, resource
+/// loading and game reset times, input latency, and frame pacing.
+class PerformanceOverlay {
+ public:
+  /// Constructs a PerformanceOverlay.
+  PerformanceOverlay();
+
+  /// Shows the overlay if it's hidden and hides it if it's shown.
+  void toggle() { visible = !visible; }
+
+  /// Returns whether the overlay is shown.
+  bool is_visible() const { return visible; }
+
+  /// Sets the duration of the last game reset.
+  ///
+  /// @param reset_time Reset duration in seconds.
+  void set_reset_time(float reset_time) { this->reset_time = reset_time; }
+
+  /// Adds the time from a fire button press to the first frame presented
+  /// after it.
+  ///
+  /// @param latency Latency in seconds.
+  void add_input_latency(float latency);
+
+  /// Draws the overlay in screen space if it's shown.
+  ///
+  /// @param target Render target.
+  /// @param profiler Profiler to read timings from.
+  /// @param allocation_tracker Allocation tracker to read allocations from.
+  /// @param collision_stats Collision statistics to read counters from.
+  /// @param world World to read entity counts from.
+  /// @param draw_calls Number of draw calls made for the world last frame.
+  /// @param frame_pacer Frame pacer to read the target frame rate and missed
+  ///   deadlines from.
+  void draw(sf::RenderTarget& target, const Profiler& profiler,
+            const AllocationTracker& allocation_tracker,
+            const CollisionStats& collision_stats, const World& world,
+            int draw_calls, const FramePacer& frame_pacer);
+
+ private:
+  /// Graph height in pixels per millisecond of frame time.
+  static constexpr float PIXELS_PER_MS = 4.f;
+
+  bool visible = false;
+
+  /// Duration of the last game reset in seconds, if any.
+  std::optional<float> reset_time;
+
+  /// Latest input latency in seconds.
+  float last_input_latency = 0.f;
+
+  /// Sum of input latencies in seconds.
+  float total_input_latency = 0.f;
+
+  /// Number of input latencies added.
+  int num_input_latencies = 0;
+
+  sf::RectangleShape background;
+  sf::VertexArray graph{sf::PrimitiveType::Lines};
+  sf::Text text;
+};
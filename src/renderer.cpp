@@ -0,0 +1,477 @@
+// Copyright (c) Tyler Veness
+
+#include "renderer.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <numbers>
+#include <string>
+#include <string_view>
+
+#include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ConvexShape.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "bullet.hpp"
+#include "colors.hpp"
+#include "laser.hpp"
+#include "player.hpp"
+#include "profiler.hpp"
+#include "resources.hpp"
+#include "update_lod.hpp"
+#include "weapon.hpp"
+#include "weapon_crate.hpp"
+#include "weapon_type.hpp"
+#include "world.hpp"
+#include "zombie.hpp"
+
+namespace {
+
+constexpr sf::Color ZOMBIE_BODY_COLOR{40, 60, 40};
+
+constexpr sf::Color WEAPON_CRATE_INNER_COLOR{60, 30, 0};
+constexpr sf::Color WEAPON_CRATE_OUTER_COLOR{100, 50, 0};
+
+constexpr sf::Color CANT_SPRINT_COLOR{128, 128, 255};
+
+/// Returns the fill color of a rectangle or convex bullet from the given
+/// weapon.
+///
+/// @param type Weapon type.
+constexpr sf::Color bullet_color(WeaponType type) {
+  using enum WeaponType;
+
+  switch (type) {
+    case HANDGUN:
+    case LASER:
+      return sf::Color::White;
+    case MACHINE_GUN:
+    case FLAMETHROWER:
+      return sf::Color::Yellow;
+    case SHOTGUN:
+      return sf::Color::Magenta;
+    case MINIGUN:
+    case ROCKET_LAUNCHER:
+      return sf::Color::Red;
+  }
+
+  return sf::Color::White;
+}
+
+/// Colors the player's body by angle around its center.
+constexpr std::string_view PLAYER_BODY_SHADER = R"(
+#version 330
+
+uniform sampler2D texture;
+uniform vec2 center;
+
+// Based on https://en.wikipedia.org/wiki/HSL_and_HSV#HSV_to_RGB_alternative
+float f(float h, float s, float v, float n) {
+  float k = mod(n + h / 60.f, 6.f);
+  return v - s * v * clamp(min(k, 4.f - k), 0.f, 1.f);
+}
+
+vec4 hsv_to_rgb(float h, float s, float v, float a) {
+  return vec4(f(h, s, v, 5), f(h, s, v, 3), f(h, s, v, 1), a);
+}
+
+void main() {
+  float angle = atan(gl_FragCoord.y - center.y, gl_FragCoord.x - center.x);  // NOLINT
+  float alpha = texture2D(texture, gl_FragCoord.xy).a;
+
+  gl_FragColor = hsv_to_rgb(degrees(angle) + 180.f, 1.f, 1.f, alpha);
+})";
+
+/// Returns the repeating ground tile.
+sf::Texture make_ground_texture() {
+  // Drawn into an image rather than a render texture so it doesn't need a
+  // framebuffer and can be made on any thread
+  sf::Image image{{20, 20}, GROUND_COLOR};
+  for (auto position : {sf::Vector2u{2, 3}, sf::Vector2u{8, 13},
+                        sf::Vector2u{15, 6}, sf::Vector2u{18, 16}}) {
+    for (unsigned int y = 0; y < 2; ++y) {
+      for (unsigned int x = 0; x < 2; ++x) {
+        image.setPixel(position + sf::Vector2u{x, y}, sf::Color{60, 60, 60});
+      }
+    }
+  }
+
+  sf::Texture texture{image};
+  texture.setRepeated(true);
+  return texture;
+}
+
+/// Returns the cached ground tile texture.
+sf::Texture& get_ground_texture() {
+  return global_resource_cache().get_texture("ground", make_ground_texture);
+}
+
+/// Returns the cached player body shader.
+sf::Shader& get_player_body_shader() {
+  return global_resource_cache().get_shader("player body", PLAYER_BODY_SHADER,
+                                            sf::Shader::Type::Fragment);
+}
+
+}  // namespace
+
+Renderer::Renderer()
+    : ground_sprite{get_ground_texture(),
+                    {{0, 0}, sf::Vector2i{MAP_BOUNDS.size}}},
+      player_body_shader{get_player_body_shader()} {
+  weapon_crate_shape.setOrigin(weapon_crate_shape.getGeometricCenter());
+  weapon_crate_shape.setFillColor(WEAPON_CRATE_INNER_COLOR);
+  weapon_crate_shape.setOutlineThickness(WeaponCrate::get_outer_width());
+  weapon_crate_shape.setOutlineColor(WEAPON_CRATE_OUTER_COLOR);
+
+  zombie_shape.setFillColor(sf::Color::Transparent);
+  zombie_shape.setOutlineColor(ZOMBIE_BODY_COLOR);
+
+  player_center_shape.setFillColor(sf::Color::Black);
+
+  for (size_t i = 0; i < ROCKET_POINTS.size(); ++i) {
+    convex_bullet_shape.setPoint(i, ROCKET_POINTS[i]);
+  }
+  convex_bullet_shape.setFillColor(bullet_color(WeaponType::ROCKET_LAUNCHER));
+
+  laser_streak_shape.setOrigin({0.f, 1.f});
+}
+
+void Renderer::preload() {
+  get_ground_texture();
+  get_player_body_shader();
+}
+
+void Renderer::draw(sf::RenderTarget& target, const World& world) {
+  draw_calls = 0;
+
+  {
+    ScopedPhaseTimer timer{Phase::DRAW_GROUND};
+    submit(target, ground_sprite);
+  }
+
+  {
+    ScopedPhaseTimer timer{Phase::DRAW_WEAPON_CRATES};
+    for (const auto& weapon_crate : world.get_weapon_crates()) {
+      draw_weapon_crate(target, weapon_crate);
+    }
+  }
+
+  {
+    ScopedPhaseTimer timer{Phase::DRAW_ZOMBIES};
+    for (const auto& zombie : world.get_zombies()) {
+      // Zombies updated at a reduced rate are outside the view
+      if (zombie.get_update_lod() == UpdateLod::FULL) {
+        draw_zombie(target, zombie);
+      }
+    }
+  }
+
+  {
+    ScopedPhaseTimer timer{Phase::DRAW_PLAYER};
+    draw_player(target, world.get_player());
+  }
+
+  {
+    ScopedPhaseTimer timer{Phase::DRAW_BULLETS};
+    for (const auto& bullet : world.get_bullets()) {
+      draw_bullet(target, bullet);
+    }
+    for (const auto& laser_streak : world.get_laser_streaks()) {
+      draw_laser_streak(target, laser_streak);
+    }
+  }
+}
+
+void Renderer::draw_weapon_crate(sf::RenderTarget& target,
+                                 const WeaponCrate& weapon_crate) {
+  weapon_crate_shape.setPosition(weapon_crate.get_position());
+  submit(target, weapon_crate_shape);
+}
+
+void Renderer::draw_zombie(sf::RenderTarget& target, const Zombie& zombie) {
+  zombie_shape.setPosition(zombie.get_position());
+  zombie_shape.setRadius(
+      std::max(0.1f, (zombie.get_max_health() - zombie.get_health()) / 10.f));
+  zombie_shape.setOrigin(zombie_shape.getGeometricCenter());
+  zombie_shape.setOutlineThickness(zombie.get_health() / 10.f);
+
+  submit(target, zombie_shape);
+}
+
+void Renderer::draw_player(sf::RenderTarget& target, const Player& player) {
+  const auto& position = player.get_position();
+
+  stamina_arc.setPosition(position);
+  for (size_t i = 0; i < 30; ++i) {
+    auto angle = sf::radians(i / 29.f * 2.0 * std::numbers::pi_v<float> *
+                             player.get_stamina() / player.get_max_stamina());
+    angle -= sf::radians(std::numbers::pi_v<float> / 2.f);
+    stamina_arc.setPoint(i, {player.get_radius() + 5.f, angle});
+  }
+  stamina_arc.setPoint(30, {0.f, 0.f});
+
+  if (player.sprint_available()) {
+    stamina_arc.setFillColor(sf::Color::Blue);
+  } else {
+    stamina_arc.setFillColor(CANT_SPRINT_COLOR);
+  }
+
+  player_body_shape.setPosition(position);
+  player_body_shape.setRadius(player.get_max_health() / 10.f);
+  player_body_shape.setOrigin(player_body_shape.getGeometricCenter());
+
+  player_center_shape.setPosition(position);
+  player_center_shape.setRadius(
+      (player.get_max_health() - player.get_health()) / 10.f);
+  player_center_shape.setOrigin(player_center_shape.getGeometricCenter());
+
+  draw_weapon(target, player.get_current_weapon(), position);
+
+  // Update shader inputs
+  player_body_shader.setUniform("texture", sf::Shader::CurrentTexture);
+  player_body_shader.setUniform(
+      "center", position - target.getView().getCenter() +
+                    sf::Vector2f{target.getSize()} / 2.f);
+
+  submit(target, stamina_arc);
+  submit(target, player_body_shape, player_body_shader_state);
+  submit(target, player_center_shape);
+}
+
+void Renderer::draw_weapon(sf::RenderTarget& target, const Weapon& weapon,
+                           const sf::Vector2f& player_position) {
+  using enum WeaponType;
+
+  sf::Vector2f symbol_center{player_position.x + 30.f, player_position.y};
+
+  constexpr sf::Color BACKGROUND_COLOR{200, 200, 200};
+  sf::RectangleShape background{{20.f, 20.f}};
+  background.setOrigin(background.getGeometricCenter());
+  background.setPosition(symbol_center);
+  background.setFillColor(BACKGROUND_COLOR);
+  submit(target, background);
+
+  // Draw weapon symbol
+  switch (weapon.type) {
+    case HANDGUN: {
+      sf::RectangleShape barrel{{15.f, 7.5f}};
+      barrel.setOrigin(barrel.getGeometricCenter());
+      barrel.setPosition(symbol_center + sf::Vector2f{1.5f, -3.f});
+      barrel.setFillColor(sf::Color::Black);
+      submit(target, barrel);
+
+      sf::RectangleShape grip{{15.f, 5.f}};
+      grip.setOrigin(grip.getGeometricCenter());
+      grip.setPosition(symbol_center + sf::Vector2f{-4.5f, 0.f});
+      grip.setRotation(sf::radians(-0.4f * std::numbers::pi_v<float>));
+      grip.setFillColor(sf::Color::Black);
+      submit(target, grip);
+      break;
+    }
+    case MACHINE_GUN: {
+      sf::RectangleShape magazine{{4.f, 2.f}};
+      magazine.setOrigin(magazine.getGeometricCenter());
+      magazine.setPosition(symbol_center + sf::Vector2f{1.f, 1.f});
+      magazine.setRotation(sf::radians(0.3f * std::numbers::pi_v<float>));
+      magazine.setFillColor(sf::Color::Black);
+      submit(target, magazine);
+
+      sf::RectangleShape barrel{{15.f, 3.f}};
+      barrel.setOrigin(barrel.getGeometricCenter());
+      barrel.setPosition(symbol_center + sf::Vector2f{1.5f, -1.5f});
+      barrel.setFillColor(sf::Color{60, 60, 60});
+      submit(target, barrel);
+
+      sf::RectangleShape grip{{7.f, 4.5f}};
+      grip.setOrigin(grip.getGeometricCenter());
+      grip.setPosition(symbol_center + sf::Vector2f{-5.5f, 0.f});
+      grip.setRotation(sf::radians(-0.025f * std::numbers::pi_v<float>));
+      grip.setFillColor(sf::Color::Black);
+      submit(target, grip);
+      break;
+    }
+    case FLAMETHROWER: {
+      constexpr sf::Color TAIL_BACK_ORANGE{170 * 9 / 10, 85 * 9 / 10, 0};
+      constexpr sf::Color TAIL_FRONT_ORANGE{170 * 11 / 10, 85 * 11 / 10, 0};
+      constexpr sf::Color HEAD_ORANGE{170 * 12 / 10, 85 * 12 / 10, 0};
+
+      sf::CircleShape tail_back{3.f};
+      tail_back.setOrigin(tail_back.getGeometricCenter());
+      tail_back.setPosition(symbol_center + sf::Vector2f{-6.5f, 0.f});
+      tail_back.setFillColor(TAIL_BACK_ORANGE);
+      submit(target, tail_back);
+
+      sf::CircleShape tail_front{4.f};
+      tail_front.setOrigin(tail_front.getGeometricCenter());
+      tail_front.setPosition(symbol_center + sf::Vector2f{-3.f, 0.f});
+      tail_front.setFillColor(TAIL_FRONT_ORANGE);
+      submit(target, tail_front);
+
+      sf::CircleShape head{6.f};
+      head.setOrigin(head.getGeometricCenter());
+      head.setPosition(symbol_center + sf::Vector2f{3.f, 0.f});
+      head.setFillColor(HEAD_ORANGE);
+      submit(target, head);
+      break;
+    }
+    case LASER: {
+      sf::CircleShape caution{10.f, 3};
+      caution.setOrigin(caution.getGeometricCenter());
+      caution.setPosition(symbol_center + sf::Vector2f{0.f, 2.f});
+      caution.setFillColor(sf::Color::Yellow);
+      caution.setOutlineThickness(1.f);
+      caution.setOutlineColor(sf::Color::Black);
+      submit(target, caution);
+
+      sf::CircleShape source{2.f};
+      source.setOrigin(source.getGeometricCenter());
+      source.setPosition(symbol_center + sf::Vector2f{0.f, 2.f});
+      source.setFillColor(sf::Color::Black);
+      submit(target, source);
+
+      sf::RectangleShape spike{{8.f, 1.f}};
+      spike.setOrigin(spike.getGeometricCenter());
+      spike.setPosition(symbol_center + sf::Vector2f{0.f, 2.f});
+      spike.setFillColor(sf::Color::Black);
+      for (int i = 0; i < 6; ++i) {
+        spike.setRotation(sf::radians(i * std::numbers::pi_v<float> / 6.f));
+        submit(target, spike);
+      }
+
+      spike.setOrigin({0.f, spike.getGeometricCenter().y});
+      spike.setRotation(sf::radians(0.f));
+      spike.setSize({7.f, 1.f});
+      submit(target, spike);
+      break;
+    }
+    case SHOTGUN: {
+      sf::RectangleShape barrel{{15.f, 3.f}};
+      barrel.setOrigin(barrel.getGeometricCenter());
+      barrel.setPosition(symbol_center + sf::Vector2f{1.5f, -1.5f});
+      barrel.setFillColor(sf::Color{60, 60, 60});
+      submit(target, barrel);
+
+      sf::RectangleShape grip{{7.f, 4.5f}};
+      grip.setOrigin(grip.getGeometricCenter());
+      grip.setPosition(symbol_center + sf::Vector2f{-5.5f, 0.f});
+      grip.setRotation(sf::radians(-0.025f * std::numbers::pi_v<float>));
+      grip.setFillColor(sf::Color{60, 30, 0});
+      submit(target, grip);
+      break;
+    }
+    case MINIGUN: {
+      constexpr int BARRELS = 5;
+
+      sf::CircleShape center_brace{1.5f};
+      center_brace.setOrigin(center_brace.getGeometricCenter());
+      center_brace.setPosition(symbol_center);
+      center_brace.setFillColor(sf::Color::Black);
+      submit(target, center_brace);
+
+      sf::CircleShape outer_brace{6.f};
+      outer_brace.setOrigin(outer_brace.getGeometricCenter());
+      outer_brace.setPosition(symbol_center);
+      outer_brace.setFillColor(sf::Color::Transparent);
+      outer_brace.setOutlineColor(sf::Color::Black);
+      outer_brace.setOutlineThickness(2.f);
+      submit(target, outer_brace);
+
+      sf::CircleShape barrel{1.f};
+      barrel.setOrigin(barrel.getGeometricCenter());
+      barrel.setFillColor(BACKGROUND_COLOR);
+      barrel.setOutlineColor(sf::Color::Black);
+      barrel.setOutlineThickness(2.f);
+      for (size_t i = 0; i < BARRELS; ++i) {
+        barrel.setPosition(
+            symbol_center +
+            sf::Vector2f{6.f, sf::radians(2.f * std::numbers::pi_v<float> /
+                                          BARRELS * i)});
+        submit(target, barrel);
+      }
+
+      break;
+    }
+    case ROCKET_LAUNCHER: {
+      sf::ConvexShape shape{ROCKET_POINTS.size()};
+      shape.setPosition(symbol_center + sf::Vector2f{0.f, -9.f});
+      shape.setRotation(sf::radians(-std::numbers::pi_v<float> / 2.f));
+      for (size_t i = 0; i < ROCKET_POINTS.size(); ++i) {
+        shape.setPoint(i, ROCKET_POINTS[i]);
+      }
+      shape.setFillColor(sf::Color::Red);
+      submit(target, shape);
+      break;
+    }
+  }
+
+  // Draw ammo count
+  sf::Text ammo_count{global_font(), std::to_string(weapon.ammo), 10};
+  ammo_count.setOrigin({ammo_count.getLocalBounds().getCenter().x, 0.f});
+  ammo_count.setPosition(
+      {player_position.x + 30.f, player_position.y + 10.f});
+
+  submit(target, ammo_count);
+}
+
+void Renderer::draw_bullet(sf::RenderTarget& target, const Bullet& bullet) {
+  switch (bullet.get_shape()) {
+    case BulletShape::RECTANGLE:
+      rectangle_bullet_shape.setSize(bullet.get_size());
+      rectangle_bullet_shape.setOrigin(bullet.get_origin());
+      rectangle_bullet_shape.setPosition(bullet.get_position());
+      rectangle_bullet_shape.setRotation(bullet.get_rotation());
+      rectangle_bullet_shape.setFillColor(bullet_color(bullet.get_type()));
+      submit(target, rectangle_bullet_shape);
+      break;
+    case BulletShape::CIRCLE: {
+      // Fade flame to black by the time it despawns
+      float decay_factor =
+          std::max(0.f, 1.f - bullet.get_age() / BULLET_MAX_LIFETIME);
+
+      circle_bullet_shape.setRadius(bullet.get_size().x / 2.f);
+      circle_bullet_shape.setOutlineThickness(bullet.get_outline_thickness());
+      circle_bullet_shape.setOrigin(bullet.get_origin());
+      circle_bullet_shape.setPosition(bullet.get_position());
+      circle_bullet_shape.setRotation(bullet.get_rotation());
+      circle_bullet_shape.setFillColor(
+          sf::Color{static_cast<uint8_t>(255.f * decay_factor),
+                    static_cast<uint8_t>(255.f * decay_factor), 0});
+      circle_bullet_shape.setOutlineColor(
+          sf::Color{static_cast<uint8_t>(255.f * decay_factor), 0, 0});
+      submit(target, circle_bullet_shape);
+      break;
+    }
+    case BulletShape::CONVEX:
+      convex_bullet_shape.setOrigin(bullet.get_origin());
+      convex_bullet_shape.setPosition(bullet.get_position());
+      convex_bullet_shape.setRotation(bullet.get_rotation());
+      submit(target, convex_bullet_shape);
+      break;
+  }
+}
+
+void Renderer::draw_laser_streak(sf::RenderTarget& target,
+                                 const LaserStreak& laser_streak) {
+  // Fade streak out by the time it despawns
+  float decay_factor =
+      std::max(0.f, 1.f - laser_streak.age / LASER_STREAK_LIFETIME);
+
+  auto delta = laser_streak.end - laser_streak.start;
+  laser_streak_shape.setSize({delta.length(), 2.f});
+  laser_streak_shape.setPosition(laser_streak.start);
+  laser_streak_shape.setRotation(delta.x != 0.f || delta.y != 0.f
+                                     ? delta.angle()
+                                     : sf::radians(0.f));
+  auto color = bullet_color(WeaponType::LASER);
+  color.a = static_cast<uint8_t>(255.f * decay_factor);
+  laser_streak_shape.setFillColor(color);
+  submit(target, laser_streak_shape);
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/ConvexShape.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "bullet.hpp"
+#include "constants.hpp"
+#include "laser.hpp"
+#include "player.hpp"
+#include "weapon.hpp"
+#include "weapon_crate.hpp"
+#include "world.hpp"
+#include "zombie.hpp"
+
+/// Draws the simulation state with SFML.
+class Renderer {
+ public:
+  /// Constructs a Renderer.
+  Renderer();
+
+  /// Loads the renderer's textures and shaders into the global resource
+  /// cache. It can be called from any thread ahead of constructing a
+  /// Renderer.
+  static void preload();
+
+  /// Draws the world on the render target.
+  ///
+  /// @param target Render target.
+  /// @param world The world to draw.
+  void draw(sf::RenderTarget& target, const World& world);
+
+  /// Returns the number of draw calls made by the last draw().
+  int get_draw_calls() const { return draw_calls; }
+
+ private:
+  int draw_calls = 0;
+
+  sf::Sprite ground_sprite;
+
+  sf::RectangleShape weapon_crate_shape{{10.f, 10.f}};
+
+  sf::CircleShape zombie_shape;
+
+  sf::ConvexShape stamina_arc{31};
+  sf::CircleShape player_body_shape;
+  sf::Shader& player_body_shader;
+  sf::RenderStates player_body_shader_state{&player_body_shader};
+  sf::CircleShape player_center_shape;
+
+  sf::RectangleShape rectangle_bullet_shape;
+  sf::CircleShape circle_bullet_shape;
+  sf::ConvexShape convex_bullet_shape{ROCKET_POINTS.size()};
+  sf::RectangleShape laser_streak_shape;
+
+  /// Draws a drawable on the render target and counts the draw call.
+  ///
+  /// @param target Render target.
+  /// @param drawable Object to draw.
+  /// @param states Render states.
+  void submit(sf::RenderTarget& target, const sf::Drawable& drawable,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+    ++draw_calls;
+    target.draw(drawable, states);
+  }
+
+  /// Draws weapon crate.
+  ///
+  /// @param target Render target.
+  /// @param weapon_crate Weapon crate.
+  void draw_weapon_crate(sf::RenderTarget& target,
+                         const WeaponCrate& weapon_crate);
+
+  /// Draws zombie.
+  ///
+  /// @param target Render target.
+  /// @param zombie Zombie.
+  void draw_zombie(sf::RenderTarget& target, const Zombie& zombie);
+
+  /// Draws player.
+  ///
+  /// @param target Render target.
+  /// @param player Player.
+  void draw_player(sf::RenderTarget& target, const Player& player);
+
+  /// Draws weapon symbol next to player.
+  ///
+  /// @param target Render target.
+  /// @param weapon Weapon.
+  /// @param player_position Player position.
+  void draw_weapon(sf::RenderTarget& target, const Weapon& weapon,
+                   const sf::Vector2f& player_position);
+
+  /// Draws bullet.
+  ///
+  /// @param target Render target.
+  /// @param bullet Bullet.
+  void draw_bullet(sf::RenderTarget& target, const Bullet& bullet);
+
+  /// Draws laser streak.
+  ///
+  /// @param target Render target.
+  /// @param laser_streak Laser streak.
+  void draw_laser_streak(sf::RenderTarget& target,
+                         const LaserStreak& laser_streak);
+};
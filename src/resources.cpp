@@ -0,0 +1,90 @@
+// Copyright (c) Tyler Veness
+
+#include "resources.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include "trace.hpp"
+
+namespace {
+
+/// Path of the application-wide font.
+constexpr std::string_view FONT_PATH = "data/arial.ttf";
+
+/// Returns a cached resource, loading it first if it isn't cached yet.
+///
+/// The lock isn't held while loading. If two threads load the same resource
+/// at once, the first to finish wins and the other's copy is discarded.
+///
+/// @param mutex Mutex guarding the cache.
+/// @param resources Resources of the requested type.
+/// @param key The resource's key.
+/// @param load_time Total load time, which the load's duration is added to.
+/// @param load Function that loads the resource.
+template <typename T, typename F>
+T& get_or_load(std::mutex& mutex,
+               std::map<std::string, T, std::less<>>& resources,
+               std::string_view key, std::chrono::duration<double>& load_time,
+               F&& load) {
+  {
+    std::scoped_lock lock{mutex};
+    if (auto resource = resources.find(key); resource != resources.end()) {
+      return resource->second;
+    }
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  T resource = load();
+  auto end_time = std::chrono::steady_clock::now();
+
+  std::scoped_lock lock{mutex};
+  load_time += end_time - start_time;
+  return resources.try_emplace(std::string{key}, std::move(resource))
+      .first->second;
+}
+
+}  // namespace
+
+sf::Font& ResourceCache::get_font(std::string_view path) {
+  return get_or_load(mutex, fonts, path, load_time, [&] {
+    TRACE_SCOPE("load font");
+    return sf::Font{std::filesystem::path{path}};
+  });
+}
+
+sf::Texture& ResourceCache::get_texture(
+    std::string_view name, const std::function<sf::Texture()>& make) {
+  return get_or_load(mutex, textures, name, load_time, [&] {
+    TRACE_SCOPE("make texture");
+    return make();
+  });
+}
+
+sf::Shader& ResourceCache::get_shader(std::string_view name,
+                                      std::string_view source,
+                                      sf::Shader::Type type) {
+  return get_or_load(mutex, shaders, name, load_time, [&] {
+    TRACE_SCOPE("compile shader");
+    return sf::Shader{source, type};
+  });
+}
+
+ResourceCache& global_resource_cache() {
+  static ResourceCache cache;
+  return cache;
+}
+
+sf::Font& global_font() {
+  return global_resource_cache().get_font(FONT_PATH);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+/// Loads fonts, textures, and shaders once and shares them for the rest of
+/// the process.
+///
+/// Fonts are keyed by file path, and textures and shaders by name. Returned
+/// references stay valid until the cache is destroyed, so objects that are
+/// rebuilt often, like everything on a game reset, don't reload or recompile
+/// anything.
+///
+/// Resources can be loaded from any thread, which lets startup load them in
+/// the background. SFML gives each thread an OpenGL context that shares
+/// textures and shaders with the window's. Resources are loaded without
+/// holding the lock, so a slow load doesn't hold up lookups of other
+/// resources.
+class ResourceCache {
+ public:
+  /// Returns a font, loading it on first use.
+  ///
+  /// @param path Font file path.
+  sf::Font& get_font(std::string_view path);
+
+  /// Returns a texture, making it on first use.
+  ///
+  /// @param name Name the texture is cached under.
+  /// @param make Function that loads or draws the texture. Only called on
+  ///   first use.
+  sf::Texture& get_texture(std::string_view name,
+                           const std::function<sf::Texture()>& make);
+
+  /// Returns a shader, compiling it on first use.
+  ///
+  /// @param name Name the shader is cached under.
+  /// @param source GLSL source. Only used on first use.
+  /// @param type Shader type.
+  sf::Shader& get_shader(std::string_view name, std::string_view source,
+                         sf::Shader::Type type);
+
+  /// Returns the number of resources loaded so far.
+  size_t get_size() const {
+    std::scoped_lock lock{mutex};
+    return fonts.size() + textures.size() + shaders.size();
+  }
+
+  /// Returns the total time spent loading resources, summed over threads.
+  std::chrono::duration<double> get_load_time() const {
+    std::scoped_lock lock{mutex};
+    return load_time;
+  }
+
+ private:
+  mutable std::mutex mutex;
+
+  std::map<std::string, sf::Font, std::less<>> fonts;
+  std::map<std::string, sf::Texture, std::less<>> textures;
+  std::map<std::string, sf::Shader, std::less<>> shaders;
+
+  std::chrono::duration<double> load_time{0.0};
+};
+
+/// Returns the application-wide resource cache.
+ResourceCache& global_resource_cache();
+
+/// Returns the application-wide font.
+sf::Font& global_font();
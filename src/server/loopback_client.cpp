@@ -0,0 +1,171 @@
+// Copyright (c) Tyler Veness
+
+#include "loopback_client.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <span>
+#include <utility>
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "bit_stream.hpp"
+#include "flee_steering.hpp"
+#include "net_protocol.hpp"
+#include "net_state.hpp"
+#include "player.hpp"
+#include "weapon_type.hpp"
+#include "world.hpp"
+#include "zombie.hpp"
+
+LoopbackClient::~LoopbackClient() {
+  if (server_port) {
+    writer.clear();
+    write_message_header(MessageType::DISCONNECT, writer);
+    auto bytes = writer.get_bytes();
+    static_cast<void>(socket.send(bytes.data(), bytes.size(),
+                                  sf::IpAddress::LocalHost, *server_port));
+  }
+}
+
+bool LoopbackClient::connect(uint16_t server_port) {
+  if (socket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) !=
+      sf::Socket::Status::Done) {
+    return false;
+  }
+  socket.setBlocking(false);
+
+  writer.clear();
+  write_message_header(MessageType::CONNECT, writer);
+  auto bytes = writer.get_bytes();
+  if (socket.send(bytes.data(), bytes.size(), sf::IpAddress::LocalHost,
+                  server_port) != sf::Socket::Status::Done) {
+    return false;
+  }
+
+  this->server_port = server_port;
+  return true;
+}
+
+void LoopbackClient::receive() {
+  size_t size;
+  std::optional<sf::IpAddress> address;
+  uint16_t port;
+  while (socket.receive(receive_buffer.data(), receive_buffer.size(), size,
+                        address, port) == sf::Socket::Status::Done) {
+    if (port != server_port) {
+      continue;
+    }
+
+    BitReader reader{std::span{receive_buffer.data(), size}};
+    if (read_message_header(reader) == MessageType::SNAPSHOT &&
+        !read_snapshot(reader)) {
+      ++rejected_snapshots;
+    }
+  }
+}
+
+void LoopbackClient::send_input() {
+  if (!server_port) {
+    return;
+  }
+
+  writer.clear();
+  if (auto state = get_newest_state(); state != nullptr) {
+    write_message_header(MessageType::INPUT, writer);
+    writer.write_bool(true);
+    writer.write(state->tick, 32);
+    write_player_input(get_input(*state), writer);
+  } else {
+    // Until a snapshot arrives, the connection request may have been lost
+    write_message_header(MessageType::CONNECT, writer);
+  }
+
+  // Lost input is replaced by the next tick's
+  auto bytes = writer.get_bytes();
+  static_cast<void>(socket.send(bytes.data(), bytes.size(),
+                                sf::IpAddress::LocalHost, *server_port));
+}
+
+const NetState* LoopbackClient::get_newest_state() const {
+  return newest_tick ? &states[*newest_tick % NET_STATE_HISTORY] : nullptr;
+}
+
+const NetState* LoopbackClient::find_state(uint32_t tick) const {
+  if (!newest_tick || *newest_tick - tick >= NET_STATE_HISTORY) {
+    return nullptr;
+  }
+
+  const auto& state = states[tick % NET_STATE_HISTORY];
+  return state.tick == tick ? &state : nullptr;
+}
+
+bool LoopbackClient::read_snapshot(BitReader& reader) {
+  uint32_t tick = reader.read(32);
+  std::optional<uint32_t> baseline_tick;
+  if (reader.read_bool()) {
+    baseline_tick = reader.read(32);
+  }
+
+  // States older than the kept ones would overwrite newer ones
+  if (newest_tick && static_cast<int32_t>(*newest_tick - tick) >=
+                         static_cast<int32_t>(NET_STATE_HISTORY)) {
+    return false;
+  }
+
+  static const NetState empty_state;
+  const NetState* baseline = &empty_state;
+  if (baseline_tick) {
+    baseline = find_state(*baseline_tick);
+    if (baseline == nullptr) {
+      return false;
+    }
+  }
+
+  if (!read_net_state_delta(*baseline, reader, decoded_state)) {
+    return false;
+  }
+
+  decoded_state.tick = tick;
+  std::swap(states[tick % NET_STATE_HISTORY], decoded_state);
+  if (!newest_tick || static_cast<int32_t>(tick - *newest_tick) > 0) {
+    newest_tick = tick;
+  }
+  return true;
+}
+
+PlayerInput LoopbackClient::get_input(const NetState& state) const {
+  sf::Vector2f position{dequantize_position(state.player.fields[0]),
+                        dequantize_position(state.player.fields[1])};
+
+  PlayerInput input;
+
+  // Flee zombies and shoot the nearest one, like the autoplay bot
+  FleeSteering steering{position, Player::get_radius(Player::MAX_HEALTH)};
+  for (const auto& zombie : state.zombies) {
+    steering.add_zombie(
+        {dequantize_position(zombie.fields[0]),
+         dequantize_position(zombie.fields[1])},
+        Zombie::get_radius(static_cast<float>(zombie.fields[3])));
+  }
+  if (const auto& nearest = steering.get_nearest_zombie_position()) {
+    input.aim_target = *nearest;
+    input.fire = true;
+  }
+  input.direction = steering.is_fleeing() ? steering.get_flee_direction()
+                                          : steering.get_edge_direction();
+
+  // Other weapons' ammo isn't sent, so try the next weapon when the current
+  // one is empty
+  if (state.player.fields[5] == 0) {
+    input.weapon =
+        static_cast<WeaponType>((state.player.fields[4] + 1) % NUM_WEAPONS);
+  }
+
+  return input;
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <SFML/Network/UdpSocket.hpp>
+
+#include "bit_stream.hpp"
+#include "net_protocol.hpp"
+#include "net_state.hpp"
+#include "world.hpp"
+
+/// Scripted client that plays against a server on the same machine.
+///
+/// It decodes snapshots like a real client would, acknowledges them, and sends
+/// input that flees and shoots the nearest zombie. It's intended for testing
+/// the server and measuring its traffic without a window.
+class LoopbackClient {
+ public:
+  LoopbackClient() = default;
+
+  LoopbackClient(const LoopbackClient&) = delete;
+  LoopbackClient& operator=(const LoopbackClient&) = delete;
+
+  /// Tells the server the client is leaving.
+  ~LoopbackClient();
+
+  /// Binds the client's socket and asks a server to connect.
+  ///
+  /// @param server_port The server's UDP port on the loopback interface.
+  /// @return False if no socket could be bound.
+  bool connect(uint16_t server_port);
+
+  /// Decodes the snapshots received since the last call.
+  void receive();
+
+  /// Sends input for the newest decoded state along with its
+  /// acknowledgement, or repeats the connection request if no state was
+  /// received yet.
+  void send_input();
+
+  /// Returns the newest decoded state, or nullptr if none was received yet.
+  const NetState* get_newest_state() const;
+
+  /// Returns the number of snapshots that were malformed or whose baseline
+  /// was no longer kept.
+  uint64_t get_rejected_snapshots() const { return rejected_snapshots; }
+
+ private:
+  sf::UdpSocket socket;
+  std::optional<uint16_t> server_port;
+
+  /// Decoded states indexed by tick modulo NET_STATE_HISTORY. Any of them may
+  /// be the baseline of a later snapshot.
+  std::array<NetState, NET_STATE_HISTORY> states;
+
+  /// Tick of the newest decoded state, if any.
+  std::optional<uint32_t> newest_tick;
+
+  /// State being decoded, kept so its lists keep their capacity.
+  NetState decoded_state;
+
+  BitWriter writer;
+  std::vector<uint8_t> receive_buffer =
+      std::vector<uint8_t>(sf::UdpSocket::MaxDatagramSize);
+
+  uint64_t rejected_snapshots = 0;
+
+  /// Returns the decoded state for a tick, or nullptr if it isn't kept.
+  ///
+  /// @param tick The tick.
+  const NetState* find_state(uint32_t tick) const;
+
+  /// Decodes a snapshot.
+  ///
+  /// @param reader Reader positioned after the message header.
+  /// @return False if the snapshot was rejected.
+  bool read_snapshot(BitReader& reader);
+
+  /// Returns scripted input for a state.
+  ///
+  /// @param state The state.
+  PlayerInput get_input(const NetState& state) const;
+};
@@ -0,0 +1,232 @@
+// Copyright (c) Tyler Veness
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <optional>
+#include <print>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "bit_stream.hpp"
+#include "frame_arena.hpp"
+#include "globals.hpp"
+#include "horde_config.hpp"
+#include "loopback_client.hpp"
+#include "net_protocol.hpp"
+#include "net_state.hpp"
+#include "parse_number.hpp"
+#include "server.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Server options.
+struct Options {
+  /// UDP port to listen on.
+  uint16_t port = DEFAULT_SERVER_PORT;
+
+  /// Run duration in seconds, or 0 to run until killed.
+  uint32_t duration = 0;
+
+  /// Seconds between report lines.
+  uint32_t report_interval = 1;
+
+  /// Random number seed, if any.
+  std::optional<uint64_t> seed;
+
+  /// Number of scripted clients to run in-process over the loopback
+  /// interface.
+  uint32_t loopback_clients = 0;
+
+  /// Zombie horde size limits.
+  HordeConfig horde_config;
+};
+
+/// Parses command-line arguments.
+///
+/// @param argc Argument count.
+/// @param argv Argument values.
+/// @param options The parsed options.
+/// @return True on success.
+bool parse_options(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    std::string_view value = i + 1 < argc ? argv[i + 1] : "";
+
+    if (arg == "--port" && parse_number(value, options.port)) {
+      ++i;
+    } else if (arg == "--duration" && parse_number(value, options.duration)) {
+      ++i;
+    } else if (arg == "--report-interval" &&
+               parse_number(value, options.report_interval) &&
+               options.report_interval > 0) {
+      ++i;
+    } else if (uint64_t seed; arg == "--seed" && parse_number(value, seed)) {
+      options.seed = seed;
+      ++i;
+    } else if (arg == "--loopback-clients" &&
+               parse_number(value, options.loopback_clients)) {
+      ++i;
+    } else if (uint32_t cap; arg == "--horde-cap" &&
+                             parse_number(value, cap) && cap > 0) {
+      options.horde_config.max_zombies = cap;
+      ++i;
+    } else if (auto ramp = horde_ramp_from_name(value);
+               arg == "--horde-ramp" && ramp) {
+      options.horde_config.ramp = *ramp;
+      ++i;
+    } else if (uint32_t duration; arg == "--horde-ramp-duration" &&
+                                  parse_number(value, duration) &&
+                                  duration > 0) {
+      options.horde_config.ramp_duration = static_cast<float>(duration);
+      ++i;
+    } else if (uint32_t wave_size; arg == "--horde-wave-size" &&
+                                   parse_number(value, wave_size) &&
+                                   wave_size > 0) {
+      options.horde_config.wave_size = wave_size;
+      ++i;
+    } else {
+      std::println(stderr,
+                   "usage: {} [--port <n>] [--duration <s>] "
+                   "[--report-interval <s>] [--seed <n>] "
+                   "[--loopback-clients <n>] [--horde-cap <n>] "
+                   "[--horde-ramp experience|linear|quadratic|immediate] "
+                   "[--horde-ramp-duration <s>] [--horde-wave-size <n>]",
+                   argv[0]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  using clock = std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  Options options;
+  if (!parse_options(argc, argv, options)) {
+    return 1;
+  }
+
+  if (options.seed) {
+    seed_global_random(*options.seed);
+  }
+
+  constexpr auto TICK_PERIOD =
+      std::chrono::nanoseconds{std::chrono::seconds{1}} / SERVER_TICK_RATE;
+  constexpr float TICK_DURATION = 1.f / SERVER_TICK_RATE;
+
+  World world;
+  world.set_horde_config(options.horde_config);
+
+  Server server;
+  if (!server.bind(options.port)) {
+    std::println(stderr, "Couldn't bind UDP port {}", options.port);
+    return 1;
+  }
+
+  std::vector<LoopbackClient> loopback_clients(options.loopback_clients);
+  for (auto& client : loopback_clients) {
+    if (!client.connect(server.get_port())) {
+      std::println(stderr, "Couldn't connect loopback client");
+      return 1;
+    }
+  }
+
+  uint32_t deaths = 0;
+
+  // Stats since the last report
+  uint64_t ticks = 0;
+  uint64_t mismatched_states = 0;
+  uint64_t reported_rejected_snapshots = 0;
+
+  // Full snapshot of the newest state, for comparison with the deltas
+  BitWriter full_writer;
+
+  std::println(
+      "time_s,ticks,clients,zombies,bullets,deaths,mean_snapshot_bytes,"
+      "max_snapshot_bytes,full_state_bytes,full_snapshots,oversized_snapshots,"
+      "rejected_snapshots,mismatched_states");
+
+  auto start_time = clock::now();
+  auto next_tick_time = start_time;
+  auto last_report_time = start_time;
+
+  while (options.duration == 0 ||
+         seconds{clock::now() - start_time}.count() < options.duration) {
+    server.receive();
+
+    // Ticks are a fixed length so every client sees the same simulation
+    world.step(TICK_DURATION, server.get_input());
+    if (world.get_player().get_health() <= 0.f) {
+      ++deaths;
+      world.reset();
+      server.invalidate_baselines();
+    }
+
+    server.send_snapshots(world);
+    ++ticks;
+
+    // Loopback clients decode what the server just sent, so their newest
+    // state should match the server's exactly
+    for (auto& client : loopback_clients) {
+      client.receive();
+      auto state = client.get_newest_state();
+      auto server_state =
+          state != nullptr ? server.get_state(state->tick) : nullptr;
+      if (state != nullptr &&
+          (server_state == nullptr || *state != *server_state)) {
+        ++mismatched_states;
+      }
+      client.send_input();
+    }
+
+    if (seconds{clock::now() - last_report_time}.count() >=
+        options.report_interval) {
+      const auto& stats = server.get_stats();
+
+      full_writer.clear();
+      write_net_state_delta(NetState{},
+                            *server.get_state(server.get_tick() - 1),
+                            full_writer);
+
+      uint64_t total_rejected_snapshots = 0;
+      for (const auto& client : loopback_clients) {
+        total_rejected_snapshots += client.get_rejected_snapshots();
+      }
+
+      std::println(
+          "{:.1f},{},{},{},{},{},{:.1f},{},{},{},{},{},{}",
+          seconds{clock::now() - start_time}.count(), ticks,
+          server.get_client_count(), world.get_zombies().size(),
+          world.get_bullets().size(), deaths,
+          stats.snapshots > 0 ? static_cast<double>(stats.snapshot_bytes) /
+                                    stats.snapshots
+                              : 0.0,
+          stats.max_snapshot_bytes, full_writer.get_bytes().size(),
+          stats.full_snapshots, stats.oversized_snapshots,
+          total_rejected_snapshots - reported_rejected_snapshots,
+          mismatched_states);
+      fflush(stdout);
+
+      last_report_time = clock::now();
+      ticks = 0;
+      mismatched_states = 0;
+      reported_rejected_snapshots = total_rejected_snapshots;
+      server.reset_stats();
+    }
+
+    global_frame_arena().reset();
+
+    // Ticks that run late are caught up on rather than skipped, so the
+    // simulation keeps pace with wall time
+    next_tick_time += TICK_PERIOD;
+    std::this_thread::sleep_until(next_tick_time);
+  }
+}
@@ -0,0 +1,159 @@
+// Copyright (c) Tyler Veness
+
+#include "server.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <span>
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include "bit_stream.hpp"
+#include "net_protocol.hpp"
+#include "net_state.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Clients that send nothing for this long are dropped.
+constexpr auto CLIENT_TIMEOUT = std::chrono::seconds{5};
+
+/// Maximum number of connected clients.
+constexpr size_t MAX_CLIENTS = 16;
+
+}  // namespace
+
+bool Server::bind(uint16_t port) {
+  if (socket.bind(port) != sf::Socket::Status::Done) {
+    return false;
+  }
+
+  // The simulation can't wait on the network
+  socket.setBlocking(false);
+  return true;
+}
+
+void Server::receive() {
+  auto now = clock::now();
+
+  size_t size;
+  std::optional<sf::IpAddress> address;
+  uint16_t port;
+  while (socket.receive(receive_buffer.data(), receive_buffer.size(), size,
+                        address, port) == sf::Socket::Status::Done) {
+    if (!address) {
+      continue;
+    }
+
+    BitReader reader{std::span{receive_buffer.data(), size}};
+    auto type = read_message_header(reader);
+    if (!type) {
+      continue;
+    }
+
+    auto client = find_client(*address, port);
+    if (*type == MessageType::CONNECT) {
+      if (client == nullptr && clients.size() < MAX_CLIENTS) {
+        clients.push_back({*address, port, std::nullopt, {}, now});
+      }
+    } else if (client != nullptr && *type == MessageType::DISCONNECT) {
+      clients.erase(clients.begin() + (client - clients.data()));
+    } else if (client != nullptr && *type == MessageType::INPUT) {
+      std::optional<uint32_t> acked_tick;
+      if (reader.read_bool()) {
+        acked_tick = reader.read(32);
+      }
+      auto input = read_player_input(reader);
+      if (!input) {
+        continue;
+      }
+
+      // Datagrams can arrive out of order, so older acknowledgements are
+      // ignored
+      if (acked_tick && (!client->acked_tick ||
+                         static_cast<int32_t>(*acked_tick -
+                                              *client->acked_tick) > 0)) {
+        client->acked_tick = acked_tick;
+      }
+      client->input = *input;
+      client->last_heard_time = now;
+    }
+  }
+
+  std::erase_if(clients, [&](const auto& client) {
+    return now - client.last_heard_time > CLIENT_TIMEOUT;
+  });
+}
+
+PlayerInput Server::get_input() const {
+  if (clients.empty()) {
+    return {};
+  }
+  return clients.front().input;
+}
+
+void Server::send_snapshots(const World& world) {
+  auto& state = states[tick % NET_STATE_HISTORY];
+  capture_net_state(world, tick, state);
+  ++tick;
+
+  for (const auto& client : clients) {
+    auto baseline = get_baseline(client);
+
+    writer.clear();
+    write_message_header(MessageType::SNAPSHOT, writer);
+    writer.write(state.tick, 32);
+    writer.write_bool(baseline != nullptr);
+    if (baseline != nullptr) {
+      writer.write(baseline->tick, 32);
+    }
+    write_net_state_delta(baseline != nullptr ? *baseline : empty_state, state,
+                          writer);
+
+    auto bytes = writer.get_bytes();
+    if (bytes.size() > sf::UdpSocket::MaxDatagramSize) {
+      ++stats.oversized_snapshots;
+      continue;
+    }
+
+    // A full send buffer drops the snapshot like the network would, and the
+    // next one is a delta against an older state instead
+    static_cast<void>(
+        socket.send(bytes.data(), bytes.size(), client.address, client.port));
+
+    ++stats.snapshots;
+    if (baseline == nullptr) {
+      ++stats.full_snapshots;
+    }
+    stats.snapshot_bytes += bytes.size();
+    stats.max_snapshot_bytes = std::max(stats.max_snapshot_bytes, bytes.size());
+  }
+}
+
+const NetState* Server::get_state(uint32_t state_tick) const {
+  if (state_tick >= tick || tick - state_tick > NET_STATE_HISTORY) {
+    return nullptr;
+  }
+  return &states[state_tick % NET_STATE_HISTORY];
+}
+
+Server::Client* Server::find_client(const sf::IpAddress& address,
+                                    uint16_t port) {
+  auto it = std::ranges::find_if(clients, [&](const auto& client) {
+    return client.address == address && client.port == port;
+  });
+  return it != clients.end() ? &*it : nullptr;
+}
+
+const NetState* Server::get_baseline(const Client& client) const {
+  if (!client.acked_tick || *client.acked_tick < first_baseline_tick) {
+    return nullptr;
+  }
+  return get_state(*client.acked_tick);
+}
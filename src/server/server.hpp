@@ -0,0 +1,143 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include "bit_stream.hpp"
+#include "net_protocol.hpp"
+#include "net_state.hpp"
+#include "world.hpp"
+
+/// Snapshot traffic counts.
+struct ServerStats {
+  /// Snapshots sent.
+  uint64_t snapshots = 0;
+
+  /// Snapshots sent without a baseline.
+  uint64_t full_snapshots = 0;
+
+  /// Total snapshot bytes sent.
+  uint64_t snapshot_bytes = 0;
+
+  /// Largest snapshot sent in bytes.
+  size_t max_snapshot_bytes = 0;
+
+  /// Snapshots not sent because they didn't fit in a datagram.
+  uint64_t oversized_snapshots = 0;
+};
+
+/// Authoritative game server.
+///
+/// The server owns the simulation and streams quantized world state to its
+/// clients over UDP. Each snapshot is a delta against the newest state the
+/// client acknowledged, so unchanged entities cost about a bit. The world has
+/// a single player, so the first client to connect controls it and the rest
+/// spectate.
+class Server {
+ public:
+  /// Binds the server's socket.
+  ///
+  /// @param port UDP port, or sf::Socket::AnyPort for any free port.
+  /// @return False if the port couldn't be bound.
+  bool bind(uint16_t port);
+
+  /// Returns the port the server is bound to.
+  uint16_t get_port() const { return socket.getLocalPort(); }
+
+  /// Handles the datagrams received since the last call and drops clients
+  /// that have gone quiet.
+  void receive();
+
+  /// Returns the controlling client's newest input, or no input if nobody is
+  /// connected.
+  PlayerInput get_input() const;
+
+  /// Captures the world's state as the next tick and sends it to every
+  /// client.
+  ///
+  /// @param world The world.
+  void send_snapshots(const World& world);
+
+  /// Stops using states captured so far as baselines. Call this when the world
+  /// is reset, since entity IDs start over.
+  void invalidate_baselines() { first_baseline_tick = tick; }
+
+  /// Returns the number of connected clients.
+  size_t get_client_count() const { return clients.size(); }
+
+  /// Returns the state captured on a tick, or nullptr if it's no longer
+  /// kept.
+  ///
+  /// @param state_tick The tick.
+  const NetState* get_state(uint32_t state_tick) const;
+
+  /// Returns the number of ticks sent so far.
+  uint32_t get_tick() const { return tick; }
+
+  /// Returns the traffic counts since the last reset_stats() call.
+  const ServerStats& get_stats() const { return stats; }
+
+  /// Resets the traffic counts.
+  void reset_stats() { stats = {}; }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  /// A connected client.
+  struct Client {
+    sf::IpAddress address;
+    uint16_t port;
+
+    /// Newest snapshot tick the client has, if any.
+    std::optional<uint32_t> acked_tick;
+
+    /// Newest input the client sent.
+    PlayerInput input;
+
+    /// When the client was last heard from.
+    clock::time_point last_heard_time;
+  };
+
+  sf::UdpSocket socket;
+  std::vector<Client> clients;
+
+  /// Recently captured states indexed by tick modulo NET_STATE_HISTORY.
+  std::array<NetState, NET_STATE_HISTORY> states;
+
+  /// Tick of the next state to be captured.
+  uint32_t tick = 0;
+
+  /// Oldest tick that may be used as a baseline.
+  uint32_t first_baseline_tick = 0;
+
+  /// Empty state that full snapshots are written against.
+  NetState empty_state;
+
+  BitWriter writer;
+  std::vector<uint8_t> receive_buffer =
+      std::vector<uint8_t>(sf::UdpSocket::MaxDatagramSize);
+
+  ServerStats stats;
+
+  /// Returns the client at an address, or nullptr if it isn't connected.
+  ///
+  /// @param address The client's IP address.
+  /// @param port The client's UDP port.
+  Client* find_client(const sf::IpAddress& address, uint16_t port);
+
+  /// Returns the state a client's next snapshot should be a delta against, or
+  /// nullptr if it needs a full snapshot.
+  ///
+  /// @param client The client.
+  const NetState* get_baseline(const Client& client) const;
+};
@@ -0,0 +1,83 @@
+// Copyright (c) Tyler Veness
+
+#include "startup.hpp"
+
+#include <stdio.h>
+
+#include <array>
+#include <chrono>
+#include <future>
+#include <print>
+#include <string_view>
+
+#include <SFML/Graphics/Font.hpp>
+
+#include "renderer.hpp"
+#include "resources.hpp"
+#include "trace.hpp"
+
+namespace {
+
+/// Character size and style of text the menus or HUD draw.
+struct TextStyle {
+  unsigned int character_size;
+  bool bold;
+};
+
+/// Text styles whose glyphs are rasterized ahead of time: menu titles, menu
+/// items, the performance overlay, and the ammo count.
+constexpr std::array TEXT_STYLES{TextStyle{50, true}, TextStyle{30, false},
+                                 TextStyle{12, false}, TextStyle{10, false}};
+
+/// When the process started, or close enough to it.
+const auto START_TIME = std::chrono::steady_clock::now();
+
+/// Rasterizes the printable ASCII glyphs of each text style, so the first
+/// frame drawing some text doesn't stall on it.
+///
+/// @param font The font.
+void rasterize_glyphs(const sf::Font& font) {
+  TRACE_SCOPE("rasterize glyphs");
+  for (const auto& style : TEXT_STYLES) {
+    for (char32_t c = U' '; c <= U'~'; ++c) {
+      static_cast<void>(font.getGlyph(c, style.character_size, style.bold));
+    }
+  }
+}
+
+}  // namespace
+
+AssetPreloader::AssetPreloader() {
+  font_loaded = std::async(std::launch::async, [] {
+                  rasterize_glyphs(global_font());
+                  log_startup_phase("font and glyphs loaded");
+                }).share();
+  graphics_loaded = std::async(std::launch::async, [] {
+                      Renderer::preload();
+                      log_startup_phase("textures and shaders loaded");
+                    }).share();
+}
+
+AssetPreloader::~AssetPreloader() {
+  // Loads can't be canceled, and the workers use the global resource cache
+  font_loaded.wait();
+  graphics_loaded.wait();
+}
+
+bool AssetPreloader::is_font_ready() const {
+  return font_loaded.wait_for(std::chrono::seconds{0}) ==
+         std::future_status::ready;
+}
+
+void AssetPreloader::wait() const {
+  font_loaded.get();
+  graphics_loaded.get();
+}
+
+void log_startup_phase(std::string_view phase) {
+  std::println("startup: {} after {:.1f} ms", phase,
+               std::chrono::duration<double, std::milli>{
+                   std::chrono::steady_clock::now() - START_TIME}
+                   .count());
+  fflush(stdout);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) Tyler Veness
+
+#pragma once
+
+#include <future>
+#include <string_view>
+
+/// Loads the game's assets into the global resource cache on worker threads,
+/// so loading overlaps creating the window and showing the main menu.
+///
+/// The font is loaded first, along with the glyphs the menus and HUD draw,
+/// since the main menu can't be shown without them. The renderer's textures
+/// and shaders load alongside it on a second thread.
+class AssetPreloader {
+ public:
+  /// Starts loading.
+  AssetPreloader();
+
+  /// Waits for loading to finish.
+  ~AssetPreloader();
+
+  AssetPreloader(const AssetPreloader&) = delete;
+  AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+  /// Returns true if the font and its glyphs are loaded. Until then, nothing
+  /// else may use the font, since rasterizing glyphs modifies it.
+  bool is_font_ready() const;
+
+  /// Waits for everything to load. Rethrows any exception a load threw.
+  void wait() const;
+
+ private:
+  std::shared_future<void> font_loaded;
+  std::shared_future<void> graphics_loaded;
+};
+
+/// Prints how long after startup a startup phase finished.
+///
+/// @param phase Name of the phase.
+void log_startup_phase(std::string_view phase);
@@ -0,0 +1,192 @@
+// Copyright (c) Tyler Veness
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <span>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "bit_stream.hpp"
+#include "bot.hpp"
+#include "frame_arena.hpp"
+#include "net_state.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Returns a state with a few entities of each type.
+NetState make_state() {
+  NetState state;
+  state.tick = 100;
+  state.player = {0, {4000, 3000, 1000, 100, 2, 250, 12345}};
+  state.zombies = {{10, {100, 200, 200, 200}},
+                   {11, {300, 400, 150, 500}},
+                   {14, {500, 600, 500, 500}}};
+  state.bullets = {{20, {700, 800, 1}}, {21, {900, 1000, 3}}};
+  state.weapon_crates = {{30, {1100, 1200, 4}}};
+  return state;
+}
+
+/// Writes a state as a delta against a baseline, reads it back, and returns
+/// the result.
+///
+/// @param baseline The baseline state.
+/// @param state The state.
+NetState round_trip(const NetState& baseline, const NetState& state) {
+  BitWriter writer;
+  write_net_state_delta(baseline, state, writer);
+
+  BitReader reader{writer.get_bytes()};
+  NetState decoded_state;
+  EXPECT_TRUE(read_net_state_delta(baseline, reader, decoded_state));
+  decoded_state.tick = state.tick;
+  return decoded_state;
+}
+
+}  // namespace
+
+TEST(BitStreamTest, VarintRoundTrip) {
+  constexpr uint32_t VALUES[]{0,       1,          127,       128,
+                              16'383,  16'384,     1u << 28,  (1u << 28) - 1,
+                              1u << 31, std::numeric_limits<uint32_t>::max()};
+
+  BitWriter writer;
+  for (uint32_t value : VALUES) {
+    writer.write_varint(value);
+  }
+
+  BitReader reader{writer.get_bytes()};
+  for (uint32_t value : VALUES) {
+    EXPECT_EQ(reader.read_varint(), value);
+  }
+  EXPECT_FALSE(reader.has_overflowed());
+}
+
+TEST(BitStreamTest, SignedRoundTrip) {
+  // Small values take 4 bits and large ones take 25, like 24-bit fields
+  constexpr int32_t VALUES[]{0,  1,  -1,        7,         -8,        8,
+                             -9, 99, -(1 << 24), (1 << 24) - 1, 1 << 23};
+
+  BitWriter writer;
+  for (int32_t value : VALUES) {
+    writer.write_signed(value, 4, 25);
+  }
+  writer.write_signed(std::numeric_limits<int32_t>::min(), 4, 32);
+  writer.write_signed(std::numeric_limits<int32_t>::max(), 4, 32);
+
+  BitReader reader{writer.get_bytes()};
+  for (int32_t value : VALUES) {
+    EXPECT_EQ(reader.read_signed(4, 25), value);
+  }
+  EXPECT_EQ(reader.read_signed(4, 32), std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(reader.read_signed(4, 32), std::numeric_limits<int32_t>::max());
+  EXPECT_FALSE(reader.has_overflowed());
+}
+
+TEST(BitStreamTest, ReadingPastEndOverflows) {
+  BitWriter writer;
+  writer.write(0x5a, 7);
+
+  BitReader reader{writer.get_bytes()};
+  EXPECT_EQ(reader.read(7), 0x5au);
+  EXPECT_FALSE(reader.has_overflowed());
+
+  // The padding bit is still in the buffer, but the bit after it isn't
+  EXPECT_EQ(reader.read(1), 0u);
+  EXPECT_FALSE(reader.has_overflowed());
+  EXPECT_EQ(reader.read(1), 0u);
+  EXPECT_TRUE(reader.has_overflowed());
+}
+
+TEST(NetStateTest, FullRoundTrip) {
+  auto state = make_state();
+  EXPECT_EQ(round_trip(NetState{}, state), state);
+}
+
+TEST(NetStateTest, DeltaRoundTripWithRemovedAndNewEntities) {
+  auto baseline = make_state();
+
+  auto state = baseline;
+  state.tick = 101;
+  state.player.fields[0] += 3;
+  state.player.fields[5] -= 1;
+
+  // First and last zombies removed, one moved, new ones with a gap in IDs
+  state.zombies.erase(state.zombies.begin());
+  state.zombies.pop_back();
+  state.zombies[0].fields[0] -= 100;
+  state.zombies.push_back({15, {1, 2, 200, 200}});
+  state.zombies.push_back({40, {16'383, 16'383, 1023, 1023}});
+
+  // Every bullet replaced
+  state.bullets = {{50, {10, 20, 5}}};
+
+  // Weapon crate unchanged
+
+  EXPECT_EQ(round_trip(baseline, state), state);
+  EXPECT_EQ(round_trip(state, baseline).zombies, baseline.zombies);
+}
+
+TEST(NetStateTest, DeltaRoundTripOfEmptyState) {
+  EXPECT_EQ(round_trip(make_state(), NetState{}), NetState{});
+}
+
+TEST(NetStateTest, DeltaRoundTripWrapsXp) {
+  auto baseline = make_state();
+  baseline.player.fields[6] = std::numeric_limits<uint32_t>::max() - 5;
+
+  auto state = baseline;
+  state.player.fields[6] = 10;
+  EXPECT_EQ(round_trip(baseline, state), state);
+  EXPECT_EQ(round_trip(state, baseline), baseline);
+}
+
+TEST(NetStateTest, DeltaRoundTripOfFullRangeAmmo) {
+  auto baseline = make_state();
+  baseline.player.fields[5] = 0;
+
+  auto state = baseline;
+  state.player.fields[5] = (1u << NET_PLAYER_BITS[5]) - 1;
+  EXPECT_EQ(round_trip(baseline, state), state);
+  EXPECT_EQ(round_trip(state, baseline), baseline);
+}
+
+TEST(NetStateTest, TruncatedDeltaIsRejected) {
+  auto baseline = make_state();
+  auto state = baseline;
+  state.zombies.push_back({41, {1, 2, 3, 4}});
+  state.bullets.clear();
+
+  BitWriter writer;
+  write_net_state_delta(baseline, state, writer);
+  auto bytes = writer.get_bytes();
+  ASSERT_GT(bytes.size(), 0u);
+
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    BitReader reader{bytes.first(size)};
+    NetState decoded_state;
+    EXPECT_FALSE(read_net_state_delta(baseline, reader, decoded_state))
+        << "accepted " << size << " of " << bytes.size() << " bytes";
+  }
+}
+
+TEST(NetStateTest, CapturedStatesRoundTrip) {
+  World world;
+  Bot bot;
+
+  // Deltas between consecutive captures cover spawns, kills, and bullets
+  // coming and going
+  NetState baseline;
+  NetState state;
+  for (uint32_t tick = 0; tick < 600; ++tick) {
+    world.step(1.f / 60.f, bot.update(world));
+    global_frame_arena().reset();
+
+    capture_net_state(world, tick, state);
+    ASSERT_EQ(round_trip(baseline, state), state) << "tick " << tick;
+    std::swap(baseline, state);
+  }
+}
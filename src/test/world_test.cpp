@@ -0,0 +1,127 @@
+// Copyright (c) Tyler Veness
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <bit>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+#include <gtest/gtest.h>
+
+#include "bot.hpp"
+#include "frame_arena.hpp"
+#include "globals.hpp"
+#include "horde_config.hpp"
+#include "job_system.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+
+namespace {
+
+/// Hashes the exact bits of a world's simulation state, so any difference
+/// between two runs changes it.
+class StateHash {
+ public:
+  /// Adds a world's state.
+  ///
+  /// @param world The world.
+  void add(const World& world) {
+    const auto& player = world.get_player();
+    add(player.get_position());
+    add(player.get_velocity());
+    add(player.get_health());
+    add(player.get_xp());
+
+    add(static_cast<uint64_t>(world.get_zombies().size()));
+    for (const auto& zombie : world.get_zombies()) {
+      add(zombie.get_id());
+      add(zombie.get_position());
+      add(zombie.get_velocity());
+      add(zombie.get_health());
+    }
+
+    add(static_cast<uint64_t>(world.get_bullets().size()));
+    for (const auto& bullet : world.get_bullets()) {
+      add(bullet.get_id());
+      add(bullet.get_position());
+      add(bullet.get_velocity());
+    }
+
+    add(static_cast<uint64_t>(world.get_weapon_crates().size()));
+    for (const auto& crate : world.get_weapon_crates()) {
+      add(crate.get_id());
+      add(crate.get_position());
+    }
+  }
+
+  /// Returns the hash.
+  uint64_t get() const { return hash; }
+
+ private:
+  /// FNV-1a hash of everything added so far.
+  uint64_t hash = 0xcbf2'9ce4'8422'2325;
+
+  void add(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash = (hash ^ ((value >> (8 * i)) & 0xff)) * 0x100'0000'01b3;
+    }
+  }
+
+  void add(uint32_t value) { add(uint64_t{value}); }
+
+  void add(float value) { add(std::bit_cast<uint32_t>(value)); }
+
+  void add(const sf::Vector2f& value) {
+    add(value.x);
+    add(value.y);
+  }
+};
+
+/// Runs the autoplay bot from a fixed seed and returns the state hash after
+/// each step.
+///
+/// @param num_threads Number of threads in the thread pool and job system.
+/// @param num_steps Number of steps.
+std::vector<uint64_t> run_bot(int num_threads, int num_steps) {
+  ThreadPool thread_pool{num_threads};
+  JobSystem job_system{num_threads};
+
+  seed_global_random(1);
+  World world;
+  world.set_thread_pool(thread_pool);
+  world.set_job_system(job_system);
+
+  // Grow the horde over the first quarter of the run so zombie movement spans
+  // several chunks for most of it
+  world.set_horde_config({.max_zombies = 2000,
+                          .ramp = HordeRamp::LINEAR,
+                          .ramp_duration = num_steps / 60.f / 4.f,
+                          .wave_size = 200});
+
+  Bot bot;
+  std::vector<uint64_t> hashes;
+  for (int step = 0; step < num_steps; ++step) {
+    world.step(1.f / 60.f, bot.update(world));
+    global_frame_arena().reset();
+
+    StateHash hash;
+    hash.add(world);
+    hashes.push_back(hash.get());
+  }
+  return hashes;
+}
+
+}  // namespace
+
+TEST(WorldTest, JobGraphMatchesSerialStep) {
+  constexpr int NUM_STEPS = 1200;
+
+  auto serial_hashes = run_bot(1, NUM_STEPS);
+  auto parallel_hashes = run_bot(4, NUM_STEPS);
+
+  // Report the first step that differs rather than every one after it
+  for (size_t step = 0; step < serial_hashes.size(); ++step) {
+    ASSERT_EQ(serial_hashes[step], parallel_hashes[step]) << "step " << step;
+  }
+}